@@ -0,0 +1,281 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#include "gitlab/gitlabrequirements.h"
+#include "gitlab/gitlabreviews.h"
+#include "issue.h"
+#include "issuecorpus.h"
+#include "jsonarraystreamparser.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtTest>
+
+using namespace benchmarks;
+
+/*!
+ * Micro benchmarks of the conversion of fetched issues, stage by stage: JSON parsing, gitlab::Issue, the date
+ * parsing inside it, the conversion to requirements/reviews and the parsing of their IDs.
+ *
+ * Each iteration runs a stage on the whole corpus of kCorpusSize issues. Besides the QtTest result (time per
+ * iteration), each stage reports its throughput in issues and MB per second.
+ */
+class ConversionBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void parseJson_data();
+    void parseJson();
+    void streamParseJson_data();
+    void streamParseJson();
+    void issueFromJson_data();
+    void issueFromJson();
+    void parseDates_data();
+    void parseDates();
+    void requirementFromIssue_data();
+    void requirementFromIssue();
+    void parseReqIfId_data();
+    void parseReqIfId();
+    void reviewFromIssue_data();
+    void reviewFromIssue();
+    void parseRevIfId_data();
+    void parseRevIfId();
+
+private:
+    struct Corpus {
+        QList<QJsonObject> objects;
+        QByteArray json; /// all issues as one JSON array, like the pages of the server put together
+        QList<gitlab::Issue> issues;
+    };
+
+    void addDescriptionSizes();
+    const Corpus &corpus(const QString &idKeyword);
+    template<typename Work>
+    void benchmarkStage(const Corpus &corpus, Work work);
+
+    QHash<QString, Corpus> m_corpora; /// by keyword and description size
+};
+
+static const int kCorpusSize = 10000;
+static const qsizetype kChunkSize = 16 * 1024; /// size of the network chunks for the stream parser
+
+void ConversionBenchmark::addDescriptionSizes()
+{
+    QTest::addColumn<int>("descriptionBytes");
+    QTest::newRow("short descriptions") << 500;
+    QTest::newRow("long descriptions") << 8000;
+}
+
+/*!
+ * Returns the corpus of the current description size, with the given ID keyword. Corpora are created only once.
+ */
+const ConversionBenchmark::Corpus &ConversionBenchmark::corpus(const QString &idKeyword)
+{
+    QFETCH(int, descriptionBytes);
+    const QString key = QString("%1/%2").arg(idKeyword).arg(descriptionBytes);
+    auto it = m_corpora.find(key);
+    if (it != m_corpora.end()) {
+        return *it;
+    }
+
+    IssueCorpus::Options options;
+    options.descriptionBytes = descriptionBytes;
+    options.idKeyword = idKeyword;
+    Corpus corpus;
+    corpus.objects = IssueCorpus(options).issues(kCorpusSize);
+    QJsonArray array;
+    for (const QJsonObject &object : std::as_const(corpus.objects)) {
+        array.append(object);
+        corpus.issues.append(gitlab::Issue(object));
+    }
+    corpus.json = QJsonDocument(array).toJson(QJsonDocument::Compact);
+    return *m_corpora.insert(key, corpus);
+}
+
+/*!
+ * Runs \a work in a QBENCHMARK loop, and reports the throughput of the stage
+ */
+template<typename Work>
+void ConversionBenchmark::benchmarkStage(const Corpus &corpus, Work work)
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    qint64 iterations = 0;
+    QBENCHMARK {
+        timer.start();
+        work();
+        nsecs += timer.nsecsElapsed();
+        ++iterations;
+    }
+
+    if (nsecs > 0) {
+        const double secsPerIteration = double(nsecs) / iterations / 1e9;
+        qInfo("%s/%s: %.0f issues/s, %.1f MB/s of JSON", QTest::currentTestFunction(), QTest::currentDataTag(),
+                corpus.issues.size() / secsPerIteration, corpus.json.size() / secsPerIteration / (1024 * 1024));
+    }
+}
+
+void ConversionBenchmark::parseJson_data()
+{
+    addDescriptionSizes();
+}
+
+void ConversionBenchmark::parseJson()
+{
+    const Corpus &data = corpus("#reqid");
+    benchmarkStage(data, [&data]() {
+        const QJsonDocument document = QJsonDocument::fromJson(data.json);
+        QCOMPARE(document.array().size(), kCorpusSize);
+    });
+}
+
+void ConversionBenchmark::streamParseJson_data()
+{
+    addDescriptionSizes();
+}
+
+void ConversionBenchmark::streamParseJson()
+{
+    const Corpus &data = corpus("#reqid");
+    benchmarkStage(data, [&data]() {
+        gitlab::JsonArrayStreamParser parser;
+        qsizetype objects = 0;
+        for (qsizetype pos = 0; pos < data.json.size(); pos += kChunkSize) {
+            objects += parser.addData(data.json.mid(pos, kChunkSize)).size();
+        }
+        QCOMPARE(objects, qsizetype(kCorpusSize));
+    });
+}
+
+void ConversionBenchmark::issueFromJson_data()
+{
+    addDescriptionSizes();
+}
+
+void ConversionBenchmark::issueFromJson()
+{
+    const Corpus &data = corpus("#reqid");
+    benchmarkStage(data, [&data]() {
+        QList<gitlab::Issue> issues;
+        issues.reserve(data.objects.size());
+        for (const QJsonObject &object : data.objects) {
+            issues.append(gitlab::Issue(object));
+        }
+        QCOMPARE(issues.size(), kCorpusSize);
+    });
+}
+
+void ConversionBenchmark::parseDates_data()
+{
+    addDescriptionSizes();
+}
+
+/*!
+ * The two ISO date parses that are part of issueFromJson
+ */
+void ConversionBenchmark::parseDates()
+{
+    const Corpus &data = corpus("#reqid");
+    benchmarkStage(data, [&data]() {
+        int valid = 0;
+        for (const QJsonObject &object : data.objects) {
+            valid += QDateTime::fromString(object["created_at"].toString(), Qt::ISODate).isValid();
+            valid += QDateTime::fromString(object["updated_at"].toString(), Qt::ISODate).isValid();
+        }
+        QCOMPARE(valid, 2 * kCorpusSize);
+    });
+}
+
+void ConversionBenchmark::requirementFromIssue_data()
+{
+    addDescriptionSizes();
+}
+
+void ConversionBenchmark::requirementFromIssue()
+{
+    const Corpus &data = corpus("#reqid");
+    benchmarkStage(data, [&data]() {
+        QList<requirement::Requirement> requirements;
+        requirements.reserve(data.issues.size());
+        for (const gitlab::Issue &issue : data.issues) {
+            requirements.append(requirement::GitLabRequirements::requirementFromIssue(issue));
+        }
+        QCOMPARE(requirements.size(), kCorpusSize);
+    });
+}
+
+void ConversionBenchmark::parseReqIfId_data()
+{
+    addDescriptionSizes();
+}
+
+void ConversionBenchmark::parseReqIfId()
+{
+    const Corpus &data = corpus("#reqid");
+    QCOMPARE(requirement::GitLabRequirements::parseReqIfId(data.issues.first()), QString("ID-000001"));
+    benchmarkStage(data, [&data]() {
+        qsizetype length = 0;
+        for (const gitlab::Issue &issue : data.issues) {
+            length += requirement::GitLabRequirements::parseReqIfId(issue).size();
+        }
+        QVERIFY(length > 0);
+    });
+}
+
+void ConversionBenchmark::reviewFromIssue_data()
+{
+    addDescriptionSizes();
+}
+
+void ConversionBenchmark::reviewFromIssue()
+{
+    const Corpus &data = corpus("#revid");
+    benchmarkStage(data, [&data]() {
+        QList<reviews::Review> reviews;
+        reviews.reserve(data.issues.size());
+        for (const gitlab::Issue &issue : data.issues) {
+            reviews.append(reviews::GitLabReviews::reviewFromIssue(issue));
+        }
+        QCOMPARE(reviews.size(), kCorpusSize);
+    });
+}
+
+void ConversionBenchmark::parseRevIfId_data()
+{
+    addDescriptionSizes();
+}
+
+void ConversionBenchmark::parseRevIfId()
+{
+    const Corpus &data = corpus("#revid");
+    QCOMPARE(reviews::GitLabReviews::parseRevIfId(data.issues.first()), QString("ID-000001"));
+    benchmarkStage(data, [&data]() {
+        qsizetype length = 0;
+        for (const gitlab::Issue &issue : data.issues) {
+            length += reviews::GitLabReviews::parseRevIfId(issue).size();
+        }
+        QVERIFY(length > 0);
+    });
+}
+
+QTEST_GUILESS_MAIN(ConversionBenchmark)
+
+#include "conversionbenchmark.moc"
@@ -0,0 +1,433 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#include "gitlabstubserver.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStringList>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrlQuery>
+
+#include <algorithm>
+#include <zlib.h>
+
+namespace benchmarks {
+
+static const int kDefaultPerPage = 20; /// per_page of the Gitlab API, if none is requested
+
+/*!
+ * Converts an issue of the REST API to an issue node of the GraphQL API, with the fields QGitlabClient asks for
+ */
+static QJsonObject graphQLNode(const QJsonObject &issue)
+{
+    QJsonArray assignees;
+    if (issue.value("assignee").isObject()) {
+        assignees.append(QJsonObject { { "name", issue["assignee"]["name"] } });
+    }
+    QJsonArray labels;
+    for (const QJsonValue &label : issue.value("labels").toArray()) {
+        labels.append(QJsonObject { { "title", label } });
+    }
+
+    QJsonObject node;
+    node["id"] = QString("gid://gitlab/Issue/%1").arg(issue["id"].toInt());
+    node["iid"] = QString::number(issue["iid"].toInt());
+    node["webUrl"] = issue["web_url"];
+    node["title"] = issue["title"];
+    node["description"] = issue["description"];
+    node["state"] = issue["state"];
+    node["type"] = issue["issue_type"].toString().toUpper();
+    node["createdAt"] = issue["created_at"];
+    node["updatedAt"] = issue["updated_at"];
+    node["userNotesCount"] = issue["user_notes_count"];
+    node["author"] = QJsonObject { { "name", issue["author"]["name"] } };
+    node["assignees"] = QJsonObject { { "nodes", assignees } };
+    node["labels"] = QJsonObject { { "nodes", labels } };
+    return node;
+}
+
+static QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200:
+        return "OK";
+    case 201:
+        return "Created";
+    case 304:
+        return "Not Modified";
+    case 404:
+        return "Not Found";
+    case 429:
+        return "Too Many Requests";
+    default:
+        return "Unknown";
+    }
+}
+
+GitlabStubServer::GitlabStubServer(const Config &config, QObject *parent)
+    : QTcpServer(parent)
+    , m_config(config)
+    , m_corpus(config.corpus)
+{
+}
+
+const GitlabStubServer::Config &GitlabStubServer::config() const
+{
+    return m_config;
+}
+
+GitlabStubServer::Stats GitlabStubServer::stats() const
+{
+    return m_stats;
+}
+
+void GitlabStubServer::resetStats()
+{
+    m_stats = Stats();
+}
+
+void GitlabStubServer::incomingConnection(qintptr socketDescriptor)
+{
+    auto socket = new QTcpSocket(this);
+    if (!socket->setSocketDescriptor(socketDescriptor)) {
+        delete socket;
+        return;
+    }
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { readRequests(socket); });
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+        m_buffers.remove(socket);
+        socket->deleteLater();
+    });
+}
+
+/*!
+ * Handles all complete requests, that were received on the \a socket. Connections are kept open for further requests.
+ */
+void GitlabStubServer::readRequests(QTcpSocket *socket)
+{
+    QByteArray &buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    while (true) {
+        const qsizetype headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            return;
+        }
+
+        const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        if (requestLine.size() < 2) {
+            qWarning() << Q_FUNC_INFO << "Invalid request" << lines.first();
+            m_buffers.remove(socket);
+            socket->disconnectFromHost();
+            return;
+        }
+
+        QByteArray host;
+        QByteArray ifNoneMatch;
+        qsizetype contentLength = 0;
+        bool acceptsDeflate = false;
+        for (qsizetype i = 1; i < lines.size(); ++i) {
+            const QByteArray line = lines.at(i).trimmed();
+            const qsizetype colon = line.indexOf(':');
+            if (colon < 0) {
+                continue;
+            }
+            const QByteArray name = line.left(colon).trimmed().toLower();
+            const QByteArray value = line.mid(colon + 1).trimmed();
+            if (name == "host") {
+                host = value;
+            } else if (name == "content-length") {
+                contentLength = value.toLongLong();
+            } else if (name == "if-none-match") {
+                ifNoneMatch = value;
+            } else if (name == "accept-encoding") {
+                acceptsDeflate = value.contains("deflate");
+            }
+        }
+
+        const qsizetype requestSize = headerEnd + 4 + contentLength;
+        if (buffer.size() < requestSize) {
+            return;
+        }
+        const QByteArray body = buffer.mid(headerEnd + 4, contentLength);
+        buffer.remove(0, requestSize);
+
+        Response response = handleRequest(requestLine.at(0), QUrl::fromEncoded(requestLine.at(1)), host, body);
+        if (requestLine.at(0) == "GET") {
+            addETag(response, ifNoneMatch);
+        }
+        if (m_config.latencyMsecs > 0) {
+            QTimer::singleShot(m_config.latencyMsecs, socket,
+                    [this, socket, response, acceptsDeflate]() { sendResponse(socket, response, acceptsDeflate); });
+        } else {
+            sendResponse(socket, response, acceptsDeflate);
+        }
+    }
+}
+
+GitlabStubServer::Response GitlabStubServer::handleRequest(
+        const QByteArray &method, const QUrl &url, const QByteArray &host, const QByteArray &body)
+{
+    ++m_stats.requests;
+    Response response;
+    if (m_config.tooManyRequestsEvery > 0 && m_stats.requests % m_config.tooManyRequestsEvery == 0) {
+        ++m_stats.rejectedRequests;
+        response.status = 429;
+        response.body = R"({"message":"429 Too Many Requests"})";
+        response.headers.append({ "Retry-After", QByteArray::number(m_config.retryAfterSecs) });
+        return response;
+    }
+
+    QStringList segments = url.path(QUrl::FullyEncoded).split('/', Qt::SkipEmptyParts);
+    if (segments == QStringList { "api", "graphql" } && method == "POST") {
+        return graphQLIssuesPage(body);
+    }
+    if (segments.size() >= 2 && segments.at(0) == "api" && segments.at(1) == "v4") {
+        segments.remove(0, 2);
+        if (segments == QStringList { "groups" }) {
+            response.body = "[]";
+            return response;
+        }
+
+        if (!segments.isEmpty() && segments.at(0) == "projects") {
+            if (segments.size() == 1 && method == "POST") {
+                response.status = 201;
+                response.body = R"({"id":2,"name":"created"})";
+                return response;
+            }
+            if (segments.size() == 2 && method == "GET") {
+                const QString path = QUrl::fromPercentEncoding(segments.at(1).toUtf8());
+                const QJsonObject project { { "id", 1 }, { "name", path.section('/', -1) },
+                    { "path_with_namespace", path }, { "web_url", m_corpus.options().projectUrl } };
+                response.body = QJsonDocument(project).toJson(QJsonDocument::Compact);
+                return response;
+            }
+            if (segments.size() == 3 && segments.at(2) == "issues") {
+                if (method == "GET") {
+                    return issuesPage(url, host);
+                }
+                if (method == "POST") {
+                    response.status = 201;
+                    response.body =
+                            QJsonDocument(m_corpus.issue(m_config.issueCount + 1)).toJson(QJsonDocument::Compact);
+                    return response;
+                }
+            }
+            if (segments.size() == 3 && segments.at(2) == "labels" && method == "GET") {
+                return labelsPage(url, host);
+            }
+            if (segments.size() == 4 && segments.at(2) == "issues" && method == "PUT") {
+                response.body = QJsonDocument(m_corpus.issue(segments.at(3).toInt())).toJson(QJsonDocument::Compact);
+                return response;
+            }
+        }
+    }
+
+    response.status = 404;
+    response.body = R"({"message":"404 Not Found"})";
+    return response;
+}
+
+GitlabStubServer::Response GitlabStubServer::issuesPage(const QUrl &url, const QByteArray &host)
+{
+    ++m_stats.issuePages;
+    const QUrlQuery query(url);
+    const int requestedPerPage = query.hasQueryItem("per_page") ? query.queryItemValue("per_page").toInt()
+                                                                : kDefaultPerPage;
+    const int perPage = std::clamp(requestedPerPage, 1, m_config.maxPerPage);
+
+    int firstIid = 1;
+    const QDateTime updatedAfter =
+            QDateTime::fromString(query.queryItemValue("updated_after", QUrl::FullyDecoded), Qt::ISODate);
+    if (updatedAfter.isValid()) {
+        firstIid = IssueCorpus::firstIidUpdatedAfter(updatedAfter);
+    }
+    const int lastIid = query.queryItemValue("state") == "closed" ? 0 : m_config.issueCount;
+    const int total = std::max(0, lastIid - firstIid + 1);
+
+    Response response;
+    int start = firstIid;
+    if (query.queryItemValue("pagination") == "keyset") {
+        if (query.hasQueryItem("id_after")) {
+            start = std::max(firstIid, query.queryItemValue("id_after").toInt() + 1);
+        }
+        const int end = std::min(lastIid, start + perPage - 1);
+        if (end < lastIid) {
+            QUrl next = url;
+            QUrlQuery nextQuery(query);
+            nextQuery.removeAllQueryItems("id_after");
+            nextQuery.addQueryItem("id_after", QString::number(end));
+            next.setQuery(nextQuery);
+            response.headers.append({ "Link", "<http://" + host + next.toEncoded() + ">; rel=\"next\"" });
+        }
+    } else {
+        const int page = std::max(1, query.queryItemValue("page").toInt());
+        start = firstIid + (page - 1) * perPage;
+        addPageHeaders(response, url, host, page, perPage, total);
+    }
+
+    QJsonArray issues;
+    for (int iid = start; iid <= lastIid && iid < start + perPage; ++iid) {
+        issues.append(m_corpus.issue(iid));
+    }
+    response.body = QJsonDocument(issues).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+/*!
+ * Answers the issues query of QGitlabClient. Only the variables that select the issues are evaluated, the fields of
+ * the nodes are always the ones QGitlabClient asks for. The cursor of a page is the IID of its last issue.
+ */
+GitlabStubServer::Response GitlabStubServer::graphQLIssuesPage(const QByteArray &body)
+{
+    ++m_stats.issuePages;
+    const QJsonObject variables = QJsonDocument::fromJson(body).object().value("variables").toObject();
+    const int perPage = std::clamp(variables.value("first").toInt(kDefaultPerPage), 1, m_config.maxPerPage);
+
+    int firstIid = 1;
+    const QDateTime updatedAfter = QDateTime::fromString(variables.value("updatedAfter").toString(), Qt::ISODate);
+    if (updatedAfter.isValid()) {
+        firstIid = IssueCorpus::firstIidUpdatedAfter(updatedAfter);
+    }
+    const int lastIid = variables.value("state").toString() == "closed" ? 0 : m_config.issueCount;
+    const QString cursor = variables.value("after").toString();
+    const int start = cursor.isEmpty()
+            ? firstIid
+            : std::max(firstIid, QByteArray::fromBase64(cursor.toLatin1()).toInt() + 1);
+    const int end = std::min(lastIid, start + perPage - 1);
+
+    QJsonArray nodes;
+    for (int iid = start; iid <= end; ++iid) {
+        nodes.append(graphQLNode(m_corpus.issue(iid)));
+    }
+    const QJsonValue endCursor = end >= start ? QJsonValue(QString::fromLatin1(QByteArray::number(end).toBase64()))
+                                              : QJsonValue();
+    const QJsonObject pageInfo { { "hasNextPage", end < lastIid }, { "endCursor", endCursor } };
+    const QJsonObject issues { { "pageInfo", pageInfo }, { "nodes", nodes } };
+    const QJsonObject data { { "project", QJsonObject { { "issues", issues } } } };
+
+    Response response;
+    response.body = QJsonDocument(QJsonObject { { "data", data } }).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+GitlabStubServer::Response GitlabStubServer::labelsPage(const QUrl &url, const QByteArray &host)
+{
+    const QUrlQuery query(url);
+    const int requestedPerPage = query.hasQueryItem("per_page") ? query.queryItemValue("per_page").toInt()
+                                                                : kDefaultPerPage;
+    const int perPage = std::clamp(requestedPerPage, 1, m_config.maxPerPage);
+    const int page = std::max(1, query.queryItemValue("page").toInt());
+    const int total = m_corpus.options().labelCount + 1;
+
+    Response response;
+    addPageHeaders(response, url, host, page, perPage, total);
+    QJsonArray labels;
+    for (int index = (page - 1) * perPage; index < total && index < page * perPage; ++index) {
+        labels.append(m_corpus.label(index));
+    }
+    response.body = QJsonDocument(labels).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+/*!
+ * Adds the ETag of the body to a successful \a response. If it matches \a ifNoneMatch, the response is turned into
+ * 304 (Not Modified) without body and pagination headers, so the client has to use what it cached
+ */
+void GitlabStubServer::addETag(Response &response, const QByteArray &ifNoneMatch)
+{
+    if (!m_config.eTags || response.status != 200) {
+        return;
+    }
+
+    const QByteArray eTag = '"' + QCryptographicHash::hash(response.body, QCryptographicHash::Md5).toHex() + '"';
+    if (ifNoneMatch == eTag) {
+        ++m_stats.notModified;
+        response.status = 304;
+        response.body.clear();
+        response.headers.clear();
+    }
+    response.headers.append({ "ETag", eTag });
+}
+
+/*!
+ * Adds the headers of offset pagination, like the Gitlab server sends them
+ */
+void GitlabStubServer::addPageHeaders(
+        Response &response, const QUrl &url, const QByteArray &host, int page, int perPage, int total)
+{
+    const int totalPages = std::max(1, (total + perPage - 1) / perPage);
+    response.headers.append({ "x-page", QByteArray::number(page) });
+    response.headers.append({ "x-per-page", QByteArray::number(perPage) });
+    response.headers.append({ "x-total", QByteArray::number(total) });
+    response.headers.append({ "x-total-pages", QByteArray::number(totalPages) });
+    response.headers.append({ "x-prev-page", page > 1 ? QByteArray::number(page - 1) : QByteArray() });
+    response.headers.append({ "x-next-page", page < totalPages ? QByteArray::number(page + 1) : QByteArray() });
+
+    auto pageLink = [&url, &host](int linkPage, const QByteArray &rel) {
+        QUrl link = url;
+        QUrlQuery query(url);
+        query.removeAllQueryItems("page");
+        query.addQueryItem("page", QString::number(linkPage));
+        link.setQuery(query);
+        return "<http://" + host + link.toEncoded() + ">; rel=\"" + rel + "\"";
+    };
+    QByteArrayList links;
+    if (page < totalPages) {
+        links.append(pageLink(page + 1, "next"));
+    }
+    links.append(pageLink(1, "first"));
+    links.append(pageLink(totalPages, "last"));
+    response.headers.append({ "Link", links.join(", ") });
+}
+
+void GitlabStubServer::sendResponse(QTcpSocket *socket, Response response, bool acceptsDeflate)
+{
+    m_stats.bodyBytes += response.body.size();
+    if (m_config.compress && acceptsDeflate && !response.body.isEmpty()) {
+        uLongf size = compressBound(uLong(response.body.size()));
+        QByteArray compressed(qsizetype(size), Qt::Uninitialized);
+        const int result = compress2(reinterpret_cast<Bytef *>(compressed.data()), &size,
+                reinterpret_cast<const Bytef *>(response.body.constData()), uLong(response.body.size()),
+                Z_BEST_SPEED);
+        if (result == Z_OK) {
+            compressed.resize(qsizetype(size));
+            response.body = compressed;
+            response.headers.append({ "Content-Encoding", "deflate" });
+        }
+    }
+    m_stats.wireBytes += response.body.size();
+
+    QByteArray head = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+    head += "Content-Type: application/json\r\n";
+    head += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    head += "Connection: keep-alive\r\n";
+    for (const auto &header : std::as_const(response.headers)) {
+        head += header.first + ": " + header.second + "\r\n";
+    }
+    head += "\r\n";
+    socket->write(head);
+    socket->write(response.body);
+}
+
+} // namespace benchmarks
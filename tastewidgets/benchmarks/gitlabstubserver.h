@@ -0,0 +1,112 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#pragma once
+
+#include "issuecorpus.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QTcpServer>
+#include <QUrl>
+
+class QTcpSocket;
+
+namespace benchmarks {
+
+/*!
+ * \brief The GitlabStubServer class is a local HTTP/1.1 server, that answers the Gitlab REST requests of
+ * QGitlabClient with synthetic data.
+ *
+ * Served endpoints (below /api/v4):
+ * - GET projects/<id or path>: the project, always with ID 1
+ * - GET projects/<id>/issues: the issues of the IssueCorpus. Supports page, per_page, pagination=keyset, state and
+ *   updated_after
+ * - GET projects/<id>/labels: the labels of the IssueCorpus
+ * - PUT projects/<id>/issues/<iid>, POST projects/<id>/issues: edits are answered with the (unchanged) issue
+ * - GET groups: an empty list
+ *
+ * And POST /api/graphql, for the issues query of QGitlabClient: the same issues, as nodes of the GraphQL API. Supports
+ * the variables first, after (cursor pagination), state and updatedAfter.
+ *
+ * The server can delay the replies, reject every n-th request with 429 (Too Many Requests), and compresses the replies
+ * if the client accepts it. GET replies carry an ETag, a request with a matching If-None-Match is answered with
+ * 304 (Not Modified) and no body.
+ */
+class GitlabStubServer : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    struct Config {
+        int issueCount = 1000;
+        int maxPerPage = 100; /// upper limit of per_page, like the Gitlab server
+        int latencyMsecs = 0; /// delay of every reply
+        int tooManyRequestsEvery = 0; /// every n-th request is answered with 429. 0 disables it
+        int retryAfterSecs = 1; /// Retry-After of the 429 replies
+        bool compress = true; /// compress the replies, if the request accepts "deflate"
+        bool eTags = true; /// send ETags, and answer requests with a matching If-None-Match with 304
+        IssueCorpus::Options corpus;
+    };
+
+    /*!
+     * Counters of the requests that were served
+     */
+    struct Stats {
+        int requests = 0;
+        int issuePages = 0;
+        int rejectedRequests = 0; /// answered with 429
+        int notModified = 0; /// answered with 304
+        qint64 bodyBytes = 0; /// uncompressed size of the reply bodies
+        qint64 wireBytes = 0; /// size of the reply bodies as sent
+    };
+
+    explicit GitlabStubServer(const Config &config, QObject *parent = nullptr);
+
+    const Config &config() const;
+    Stats stats() const;
+    void resetStats();
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    struct Response {
+        int status = 200;
+        QByteArray body;
+        QList<QPair<QByteArray, QByteArray>> headers;
+    };
+
+    void readRequests(QTcpSocket *socket);
+    Response handleRequest(const QByteArray &method, const QUrl &url, const QByteArray &host, const QByteArray &body);
+    Response issuesPage(const QUrl &url, const QByteArray &host);
+    Response graphQLIssuesPage(const QByteArray &body);
+    Response labelsPage(const QUrl &url, const QByteArray &host);
+    void addETag(Response &response, const QByteArray &ifNoneMatch);
+    void addPageHeaders(Response &response, const QUrl &url, const QByteArray &host, int page, int perPage, int total);
+    void sendResponse(QTcpSocket *socket, Response response, bool acceptsDeflate);
+
+    Config m_config;
+    IssueCorpus m_corpus;
+    Stats m_stats;
+    QHash<QTcpSocket *, QByteArray> m_buffers; /// data received but not handled yet, per connection
+};
+
+} // namespace benchmarks
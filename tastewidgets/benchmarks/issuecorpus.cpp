@@ -0,0 +1,143 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#include "issuecorpus.h"
+
+#include <QJsonArray>
+#include <QRandomGenerator>
+#include <QStringList>
+
+namespace benchmarks {
+
+static const QStringList kWords = { "the", "component", "shall", "provide", "telemetry", "interface", "within",
+    "milliseconds", "after", "receiving", "command", "mode", "safe", "nominal", "power", "thermal", "attitude",
+    "control", "software", "data", "handling", "onboard", "computer", "ground", "segment", "link", "budget", "margin",
+    "verification", "test", "analysis", "inspection", "review", "design", "requirement", "function", "packet",
+    "service", "monitoring", "failure", "detection", "isolation", "recovery" };
+
+static const QDateTime kBaseTime = QDateTime(QDate(2024, 1, 1), QTime(0, 0), Qt::UTC);
+static const int kSecsBetweenUpdates = 60;
+
+IssueCorpus::IssueCorpus(const Options &options)
+    : m_options(options)
+{
+}
+
+const IssueCorpus::Options &IssueCorpus::options() const
+{
+    return m_options;
+}
+
+QJsonObject IssueCorpus::issue(int iid) const
+{
+    QJsonArray labels = { m_options.typeLabel };
+    if (m_options.labelCount > 0) {
+        labels.append(QString("tag-%1").arg(iid % m_options.labelCount));
+        if (iid % 3 == 0) {
+            labels.append(QString("tag-%1").arg((iid / 3) % m_options.labelCount));
+        }
+    }
+
+    QJsonObject issue;
+    issue["id"] = 100000 + iid;
+    issue["iid"] = iid;
+    issue["project_id"] = 1;
+    issue["title"] = QString("Synthetic issue %1: %2 %3").arg(iid).arg(kWords.at(iid % kWords.size()),
+            kWords.at((iid * 7) % kWords.size()));
+    issue["description"] = description(iid);
+    issue["state"] = "opened";
+    issue["created_at"] = kBaseTime.addSecs(iid).toString(Qt::ISODateWithMs);
+    issue["updated_at"] = updatedAt(iid).toString(Qt::ISODateWithMs);
+    issue["labels"] = labels;
+    issue["author"] = QJsonObject { { "id", 1 + iid % 5 }, { "name", QString("Author %1").arg(iid % 5) } };
+    if (iid % 2 == 0) {
+        issue["assignee"] = QJsonObject { { "id", 10 + iid % 4 }, { "name", QString("Assignee %1").arg(iid % 4) } };
+    } else {
+        issue["assignee"] = QJsonValue::Null;
+    }
+    issue["issue_type"] = "issue";
+    issue["user_notes_count"] = iid % 11;
+    issue["web_url"] = QString("%1/-/issues/%2").arg(m_options.projectUrl).arg(iid);
+    return issue;
+}
+
+QList<QJsonObject> IssueCorpus::issues(int count) const
+{
+    QList<QJsonObject> result;
+    result.reserve(count);
+    for (int iid = 1; iid <= count; ++iid) {
+        result.append(issue(iid));
+    }
+    return result;
+}
+
+QJsonObject IssueCorpus::label(int index) const
+{
+    const QString name = index == 0 ? m_options.typeLabel : QString("tag-%1").arg(index - 1);
+    return QJsonObject { { "id", 500 + index }, { "name", name }, { "description", QString("Label %1").arg(name) },
+        { "color", QString("#%1").arg((index * 0x3b5d1f) & 0xffffff, 6, 16, QChar('0')) } };
+}
+
+QDateTime IssueCorpus::updatedAt(int iid)
+{
+    return kBaseTime.addSecs(qint64(iid) * kSecsBetweenUpdates);
+}
+
+int IssueCorpus::firstIidUpdatedAfter(const QDateTime &time)
+{
+    if (!time.isValid()) {
+        return 1;
+    }
+    const qint64 secs = kBaseTime.secsTo(time);
+    if (secs < 0) {
+        return 1;
+    }
+    return int(secs / kSecsBetweenUpdates) + 1;
+}
+
+/*!
+ * A Markdown document with a heading, paragraphs of pseudo random words and the ID line after the first paragraph
+ */
+QString IssueCorpus::description(int iid) const
+{
+    QRandomGenerator random(quint32(iid));
+    QString text;
+    text.reserve(m_options.descriptionBytes + 100);
+    text += QString("## Synthetic issue %1\n\n").arg(iid);
+
+    bool idWritten = false;
+    int wordsInParagraph = 0;
+    while (text.size() < m_options.descriptionBytes || !idWritten) {
+        text += kWords.at(random.bounded(int(kWords.size())));
+        ++wordsInParagraph;
+        if (wordsInParagraph < 60) {
+            text += ' ';
+            continue;
+        }
+
+        text += ".\n\n";
+        wordsInParagraph = 0;
+        if (!idWritten && text.size() >= m_options.descriptionBytes / 2) {
+            text += QString("%1: \"ID-%2\"\n\n").arg(m_options.idKeyword).arg(iid, 6, 10, QChar('0'));
+            idWritten = true;
+        }
+    }
+    return text;
+}
+
+} // namespace benchmarks
@@ -0,0 +1,77 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#pragma once
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+namespace benchmarks {
+
+/*!
+ * \brief The IssueCorpus class generates synthetic Gitlab issues, as returned by the issues API.
+ *
+ * The issues are deterministic: the same options and IID always give the same issue. The descriptions are Markdown
+ * documents of about the configured size, with the ID line ("#reqid: ..." or "#revid: ...") in the middle.
+ */
+class IssueCorpus
+{
+public:
+    struct Options {
+        int descriptionBytes = 2000; /// approximate size of each description
+        QString typeLabel = "requirement"; /// label every issue has
+        QString idKeyword = "#reqid"; /// keyword of the ID line in the description
+        int labelCount = 20; /// number of labels of the project, besides the type label
+        QString projectUrl = "https://gitlab.example.com/bench/project";
+    };
+
+    explicit IssueCorpus(const Options &options = Options());
+
+    const Options &options() const;
+
+    /*!
+     * \brief Returns the issue with the given IID (starting at 1) as JSON object
+     */
+    QJsonObject issue(int iid) const;
+    /*!
+     * \brief Returns the issues with the IIDs 1 to \a count
+     */
+    QList<QJsonObject> issues(int count) const;
+    /*!
+     * \brief Returns the label with the given index as JSON object. Index 0 is the type label
+     */
+    QJsonObject label(int index) const;
+
+    /*!
+     * \brief Time of the last update of the issue. Issues with a higher IID were updated later
+     */
+    static QDateTime updatedAt(int iid);
+    /*!
+     * \brief Returns the lowest IID that was updated after \a time
+     */
+    static int firstIidUpdatedAfter(const QDateTime &time);
+
+private:
+    QString description(int iid) const;
+
+    Options m_options;
+};
+
+} // namespace benchmarks
@@ -0,0 +1,338 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#include "gitlabstubserver.h"
+#include "requirementsmanager.h"
+#include "requirementsmodelbase.h"
+#include "reviewsmanager.h"
+#include "reviewsmodelbase.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTableView>
+#include <QTextStream>
+#include <QTimer>
+
+#include <memory>
+
+using namespace benchmarks;
+
+namespace {
+
+const int kTimeoutMsecs = 10 * 60 * 1000;
+
+/*!
+ * Requirements model, that measures the time spent inserting the fetched requirements
+ */
+class TimedRequirementsModel : public requirement::RequirementsModelBase
+{
+public:
+    using RequirementsModelBase::RequirementsModelBase;
+
+    void addRequirements(const QList<requirement::Requirement> &requirements) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        RequirementsModelBase::addRequirements(requirements);
+        insertNsecs += timer.nsecsElapsed();
+    }
+
+    void updateRequirements(const QList<requirement::Requirement> &requirements) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        RequirementsModelBase::updateRequirements(requirements);
+        insertNsecs += timer.nsecsElapsed();
+    }
+
+    qint64 insertNsecs = 0;
+};
+
+/*!
+ * Reviews model, that measures the time spent inserting the fetched reviews
+ */
+class TimedReviewsModel : public reviews::ReviewsModelBase
+{
+public:
+    using ReviewsModelBase::ReviewsModelBase;
+
+    void addReviews(const QList<reviews::Review> &reviews) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        ReviewsModelBase::addReviews(reviews);
+        insertNsecs += timer.nsecsElapsed();
+    }
+
+    void updateReviews(const QList<reviews::Review> &reviews) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        ReviewsModelBase::updateReviews(reviews);
+        insertNsecs += timer.nsecsElapsed();
+    }
+
+    qint64 insertNsecs = 0;
+};
+
+struct RequirementsTraits {
+    using Manager = requirement::RequirementsManager;
+    using Model = TimedRequirementsModel;
+    static constexpr auto fetchingEnded = &Manager::fetchingRequirementsEnded;
+    static constexpr const char *name = "requirements";
+    static void requestAll(Manager &manager) { manager.requestAllRequirements(); }
+    static void requestUpdate(Manager &manager) { manager.requestRequirementsUpdate(); }
+};
+
+struct ReviewsTraits {
+    using Manager = reviews::ReviewsManager;
+    using Model = TimedReviewsModel;
+    static constexpr auto fetchingEnded = &Manager::fetchingReviewsEnded;
+    static constexpr const char *name = "reviews";
+    static void requestAll(Manager &manager) { manager.requestAllReviews(); }
+    static void requestUpdate(Manager &manager) { manager.requestReviewsUpdate(); }
+};
+
+struct Result {
+    bool ok = false;
+    int rows = 0;
+    qint64 fullRefreshMsecs = -1;
+    qint64 updateMsecs = -1; /// incremental refresh without changes
+    qint64 refetchMsecs = -1; /// second full refresh, the pages are revalidated with their ETags
+    int notModifiedPages = 0; /// pages of the second full refresh answered with 304
+    qint64 insertMsecs = -1;
+    qint64 rssDeltaKB = -1; /// growth of the resident memory by the full refresh
+    qint64 peakRssKB = -1; /// peak resident memory of the process so far
+    GitlabStubServer::Stats server;
+};
+
+/*!
+ * Returns a memory value of /proc/self/status in kB, like "VmRSS:". -1 if it's not available (not Linux)
+ */
+qint64 memoryStatusKB(const QByteArray &key)
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+    const QList<QByteArray> lines = status.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith(key)) {
+            return line.mid(key.size()).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+
+/*!
+ * Runs the event loop until \a sender emits \a signal. Returns false on a connection error or timeout
+ */
+template<typename Sender, typename Signal>
+bool waitFor(Sender *sender, Signal signal)
+{
+    QEventLoop loop;
+    bool done = false;
+    QObject::connect(sender, signal, &loop, [&]() {
+        done = true;
+        loop.quit();
+    });
+    QObject::connect(sender, &tracecommon::IssuesManager::connectionError, &loop, [&](const QString &error) {
+        QTextStream(stderr) << "Connection error: " << error << Qt::endl;
+        loop.quit();
+    });
+    QTimer::singleShot(kTimeoutMsecs, &loop, &QEventLoop::quit);
+    loop.exec();
+    return done;
+}
+
+/*!
+ * Does a full refresh, an incremental refresh and a second full refresh against a stub server with the given
+ * \a config
+ */
+template<typename Traits>
+Result runRefresh(const GitlabStubServer::Config &config, bool graphQL, bool withView, const QString &traceDir)
+{
+    Result result;
+    GitlabStubServer server(config);
+    if (!server.listen(QHostAddress::LocalHost)) {
+        QTextStream(stderr) << "Unable to start the stub server: " << server.errorString() << Qt::endl;
+        return result;
+    }
+
+    typename Traits::Manager manager;
+    typename Traits::Model model(&manager);
+    std::unique_ptr<QTableView> view;
+    if (withView) {
+        view = std::make_unique<QTableView>();
+        view->setModel(&model);
+        view->show();
+    }
+
+    manager.setUseGraphQL(graphQL);
+    manager.setCredentials(QString("http://127.0.0.1:%1/bench/project").arg(server.serverPort()), "benchmark");
+    while (!manager.hasValidProjectID()) {
+        if (!waitFor(&manager, &tracecommon::IssuesManager::projectIDChanged)) {
+            return result;
+        }
+    }
+
+    server.resetStats();
+    const qint64 rssBefore = memoryStatusKB("VmRSS:");
+    QElapsedTimer timer;
+    timer.start();
+    Traits::requestAll(manager);
+    if (!waitFor(&manager, Traits::fetchingEnded)) {
+        return result;
+    }
+    result.fullRefreshMsecs = timer.elapsed();
+    result.rows = model.rowCount();
+    result.insertMsecs = model.insertNsecs / 1000000;
+    result.server = server.stats();
+    result.rssDeltaKB = memoryStatusKB("VmRSS:") - rssBefore;
+
+    timer.restart();
+    Traits::requestUpdate(manager);
+    if (waitFor(&manager, Traits::fetchingEnded)) {
+        result.updateMsecs = timer.elapsed();
+    }
+
+    // Nothing changed on the server, so the pages cached by the first full refresh are not downloaded again
+    server.resetStats();
+    timer.restart();
+    Traits::requestAll(manager);
+    if (waitFor(&manager, Traits::fetchingEnded)) {
+        result.refetchMsecs = timer.elapsed();
+        result.notModifiedPages = server.stats().notModified;
+    }
+    result.peakRssKB = memoryStatusKB("VmHWM:");
+    result.ok = result.rows == config.issueCount && model.rowCount() == config.issueCount && result.updateMsecs >= 0
+            && result.refetchMsecs >= 0;
+
+    if (!traceDir.isEmpty()) {
+        const QString fileName =
+                QString("%1-%2%3.json").arg(Traits::name).arg(config.issueCount).arg(graphQL ? "-graphql" : "");
+        manager.exportRequestTrace(QDir(traceDir).filePath(fileName));
+    }
+    return result;
+}
+
+} // namespace
+
+/*!
+ * End to end benchmark of a refresh: QGitlabClient, manager and model against a local stub server.
+ * Reports the time of a full, an incremental and a repeated full refresh (with the pages answered by 304), the time
+ * spent inserting into the model, the transferred bytes and the memory use, for each number of issues.
+ * With --graphql, every run is repeated with the GraphQL API, to compare the transferred bytes with the ones of the
+ * REST API.
+ */
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("refreshbenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Offline refresh benchmark against a local Gitlab stub server");
+    parser.addHelpOption();
+    const QCommandLineOption issuesOption(
+            "issues", "Comma separated numbers of issues.", "counts", "100,1000,10000,50000");
+    const QCommandLineOption perPageOption("max-per-page", "Maximum page size of the server.", "count", "100");
+    const QCommandLineOption latencyOption("latency", "Delay of every reply in ms.", "msecs", "0");
+    const QCommandLineOption rateLimitOption(
+            "rate-limit-every", "Answer every n-th request with 429 (0 disables it).", "n", "0");
+    const QCommandLineOption descriptionOption(
+            "description-bytes", "Approximate size of the issue descriptions.", "bytes", "2000");
+    const QCommandLineOption noCompressionOption("no-compression", "Never compress the replies.");
+    const QCommandLineOption noETagsOption("no-etags", "Never send ETags, so no page is answered with 304.");
+    const QCommandLineOption reviewsOption("reviews", "Fetch reviews instead of requirements.");
+    const QCommandLineOption graphQLOption(
+            "graphql", "Repeat every run with the GraphQL API, and compare the transferred bytes.");
+    const QCommandLineOption viewOption("view", "Show the model in a table view.");
+    const QCommandLineOption traceOption("trace", "Write a Chrome trace of each run to the directory.", "dir");
+    parser.addOptions({ issuesOption, perPageOption, latencyOption, rateLimitOption, descriptionOption,
+            noCompressionOption, noETagsOption, reviewsOption, graphQLOption, viewOption, traceOption });
+    parser.process(app);
+
+    // Keep the issue and project caches apart from the ones of the user
+    QStandardPaths::setTestModeEnabled(true);
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+    cacheDir.removeRecursively();
+
+    GitlabStubServer::Config config;
+    config.maxPerPage = parser.value(perPageOption).toInt();
+    config.latencyMsecs = parser.value(latencyOption).toInt();
+    config.tooManyRequestsEvery = parser.value(rateLimitOption).toInt();
+    config.compress = !parser.isSet(noCompressionOption);
+    config.eTags = !parser.isSet(noETagsOption);
+    config.corpus.descriptionBytes = parser.value(descriptionOption).toInt();
+    const bool fetchReviews = parser.isSet(reviewsOption);
+    if (fetchReviews) {
+        config.corpus.typeLabel = "review";
+        config.corpus.idKeyword = "#revid";
+    }
+
+    QTextStream out(stdout);
+    out << QString::asprintf("%-16s %8s %6s %6s %9s %9s %10s %6s %9s %10s %10s %9s %9s", "kind", "issues", "pages",
+                   "429s", "full_ms", "update_ms", "refetch_ms", "304s", "insert_ms", "wire_kB", "body_kB",
+                   "rss+_MB", "peak_MB")
+        << Qt::endl;
+
+    bool allOk = true;
+    const QList<bool> backends = parser.isSet(graphQLOption) ? QList<bool> { false, true } : QList<bool> { false };
+    for (const QString &count : parser.value(issuesOption).split(',', Qt::SkipEmptyParts)) {
+        config.issueCount = count.toInt();
+        qint64 restWireBytes = 0;
+        for (bool graphQL : backends) {
+            const Result result = fetchReviews
+                    ? runRefresh<ReviewsTraits>(config, graphQL, parser.isSet(viewOption), parser.value(traceOption))
+                    : runRefresh<RequirementsTraits>(
+                            config, graphQL, parser.isSet(viewOption), parser.value(traceOption));
+            const QString kind = QString("%1%2").arg(
+                    fetchReviews ? ReviewsTraits::name : RequirementsTraits::name, graphQL ? "-graphql" : "");
+            out << QString::asprintf("%-16s %8d %6d %6d %9lld %9lld %10lld %6d %9lld %10lld %10lld %9.1f %9.1f",
+                           qPrintable(kind), config.issueCount, result.server.issuePages,
+                           result.server.rejectedRequests, result.fullRefreshMsecs, result.updateMsecs,
+                           result.refetchMsecs, result.notModifiedPages, result.insertMsecs,
+                           result.server.wireBytes / 1024, result.server.bodyBytes / 1024, result.rssDeltaKB / 1024.0,
+                           result.peakRssKB / 1024.0)
+                << Qt::endl;
+            if (!graphQL) {
+                restWireBytes = result.server.wireBytes;
+            } else if (restWireBytes > 0) {
+                out << QString::asprintf("%-16s wire bytes of the full refresh: %.1f%% of REST", "",
+                               100.0 * result.server.wireBytes / restWireBytes)
+                    << Qt::endl;
+            }
+            if (!result.ok) {
+                QTextStream(stderr) << "Run with " << config.issueCount << " issues" << (graphQL ? " (GraphQL)" : "")
+                                    << " failed, got " << result.rows << " rows" << Qt::endl;
+                allOk = false;
+            }
+        }
+    }
+
+    cacheDir.removeRecursively();
+    return allOk ? 0 : 1;
+}
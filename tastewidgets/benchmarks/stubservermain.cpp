@@ -0,0 +1,76 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#include "gitlabstubserver.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+
+using namespace benchmarks;
+
+/*!
+ * Runs the Gitlab stub server standalone, for example to point the requirements or reviews widget to it:
+ * `gitlabstubserver --issues 10000 --latency 50` and use "http://127.0.0.1:8090/bench/project" as project url
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("gitlabstubserver");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Local Gitlab API stub serving synthetic issues");
+    parser.addHelpOption();
+    const QCommandLineOption portOption("port", "Port to listen on.", "port", "8090");
+    const QCommandLineOption issuesOption("issues", "Number of issues.", "count", "1000");
+    const QCommandLineOption perPageOption("max-per-page", "Maximum page size.", "count", "100");
+    const QCommandLineOption latencyOption("latency", "Delay of every reply in ms.", "msecs", "0");
+    const QCommandLineOption rateLimitOption(
+            "rate-limit-every", "Answer every n-th request with 429 (0 disables it).", "n", "0");
+    const QCommandLineOption descriptionOption(
+            "description-bytes", "Approximate size of the issue descriptions.", "bytes", "2000");
+    const QCommandLineOption noCompressionOption("no-compression", "Never compress the replies.");
+    const QCommandLineOption noETagsOption("no-etags", "Never send ETags, and never answer with 304.");
+    const QCommandLineOption reviewsOption("reviews", "Serve reviews instead of requirements.");
+    parser.addOptions({ portOption, issuesOption, perPageOption, latencyOption, rateLimitOption, descriptionOption,
+            noCompressionOption, noETagsOption, reviewsOption });
+    parser.process(app);
+
+    GitlabStubServer::Config config;
+    config.issueCount = parser.value(issuesOption).toInt();
+    config.maxPerPage = parser.value(perPageOption).toInt();
+    config.latencyMsecs = parser.value(latencyOption).toInt();
+    config.tooManyRequestsEvery = parser.value(rateLimitOption).toInt();
+    config.compress = !parser.isSet(noCompressionOption);
+    config.eTags = !parser.isSet(noETagsOption);
+    config.corpus.descriptionBytes = parser.value(descriptionOption).toInt();
+    if (parser.isSet(reviewsOption)) {
+        config.corpus.typeLabel = "review";
+        config.corpus.idKeyword = "#revid";
+    }
+
+    GitlabStubServer server(config);
+    if (!server.listen(QHostAddress::LocalHost, quint16(parser.value(portOption).toUInt()))) {
+        QTextStream(stderr) << "Unable to listen: " << server.errorString() << Qt::endl;
+        return 1;
+    }
+
+    QTextStream(stdout) << "Serving " << config.issueCount << " issues on http://127.0.0.1:" << server.serverPort()
+                        << "/bench/project" << Qt::endl;
+    return app.exec();
+}
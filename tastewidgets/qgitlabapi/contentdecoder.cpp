@@ -0,0 +1,87 @@
+#include "contentdecoder.h"
+
+#include <QDebug>
+
+#include <zlib.h>
+
+using namespace gitlab;
+
+static const int kChunkSize = 64 * 1024;
+
+ContentDecoder::ContentDecoder(const QByteArray &contentEncoding)
+{
+    const QByteArray encoding = contentEncoding.trimmed().toLower();
+    if (encoding != "gzip" && encoding != "x-gzip" && encoding != "deflate") {
+        return;
+    }
+
+    mStream = std::make_unique<z_stream_s>();
+    mStream->zalloc = Z_NULL;
+    mStream->zfree = Z_NULL;
+    mStream->opaque = Z_NULL;
+    mStream->next_in = Z_NULL;
+    mStream->avail_in = 0;
+    // 32 enables the detection of the gzip and the zlib header, "deflate" is sent zlib wrapped by the servers
+    if (inflateInit2(mStream.get(), 32 + MAX_WBITS) != Z_OK) {
+        qWarning() << Q_FUNC_INFO << "Unable to initialize zlib";
+        mStream.reset();
+        mError = true;
+    }
+}
+
+ContentDecoder::~ContentDecoder()
+{
+    if (mStream) {
+        inflateEnd(mStream.get());
+    }
+}
+
+bool ContentDecoder::isSupported(const QByteArray &contentEncoding)
+{
+    const QByteArray encoding = contentEncoding.trimmed().toLower();
+    return encoding.isEmpty() || encoding == "identity" || encoding == "gzip" || encoding == "x-gzip"
+            || encoding == "deflate";
+}
+
+QByteArray ContentDecoder::decode(const QByteArray &data)
+{
+    if (!mStream) {
+        return mError ? QByteArray() : data;
+    }
+    if (mFinished || mError || data.isEmpty()) {
+        return {};
+    }
+
+    QByteArray decoded;
+    mStream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    mStream->avail_in = uInt(data.size());
+    do {
+        const qsizetype offset = decoded.size();
+        decoded.resize(offset + kChunkSize);
+        mStream->next_out = reinterpret_cast<Bytef *>(decoded.data() + offset);
+        mStream->avail_out = kChunkSize;
+        const int result = inflate(mStream.get(), Z_NO_FLUSH);
+        decoded.resize(offset + kChunkSize - mStream->avail_out);
+        if (result == Z_STREAM_END) {
+            mFinished = true;
+            break;
+        }
+        if (result != Z_OK && result != Z_BUF_ERROR) {
+            qWarning() << Q_FUNC_INFO << "Inflating the reply failed:" << (mStream->msg ? mStream->msg : "");
+            mError = true;
+            break;
+        }
+    } while (mStream->avail_out == 0);
+
+    return decoded;
+}
+
+bool ContentDecoder::isCompressed() const
+{
+    return mStream != nullptr;
+}
+
+bool ContentDecoder::hasError() const
+{
+    return mError;
+}
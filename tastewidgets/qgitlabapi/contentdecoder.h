@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QByteArray>
+
+#include <memory>
+
+struct z_stream_s;
+
+namespace gitlab {
+
+/**
+ * @brief The ContentDecoder class decodes the body of a reply, that was sent with a Content-Encoding.
+ *
+ * The body can be passed in chunks as it arrives. "gzip" and "deflate" are inflated, all other encodings (including
+ * "identity" and no encoding at all) are passed through unchanged.
+ */
+class ContentDecoder
+{
+public:
+    explicit ContentDecoder(const QByteArray &contentEncoding);
+    ~ContentDecoder();
+
+    /**
+     * @brief isSupported returns true if the body with that content encoding can be read
+     */
+    static bool isSupported(const QByteArray &contentEncoding);
+
+    /**
+     * @brief decode decodes the next chunk of the body
+     * @return the decoded data of that chunk
+     */
+    QByteArray decode(const QByteArray &data);
+    bool isCompressed() const;
+    bool hasError() const;
+
+private:
+    std::unique_ptr<z_stream_s> mStream; /// not set for uncompressed bodies
+    bool mFinished = false;
+    bool mError = false;
+};
+
+}
@@ -5,27 +5,244 @@
 
 using namespace gitlab;
 
+namespace gitlab {
+
+class IssueData : public QSharedData
+{
+public:
+    QUrl mUrl;
+    int mIssueID = -1;
+    int mIssueIID = -1;
+    QString mTitle;
+    QString mDescription;
+    QString mAuthor;
+    QString mAssignee;
+    QString mState;
+    QString mState_event;
+    QStringList mLabels;
+    QString mIssueType;
+    QDateTime mCreatedAt;
+    QDateTime mUpdatedAt;
+    int mNotesCount = 0;
+};
+
+}
+
+Issue::Issue()
+    : d(new IssueData)
+{
+}
+
 Issue::Issue(const QJsonObject &issue)
+    : d(new IssueData)
 {
-    mUrl = issue["web_url"].toString();
-    mIssueID = issue["id"].toInteger();
-    mIssueIID = issue["iid"].toInteger();
-    mTitle = issue["title"].toString();
-    mDescription = issue["description"].toString();
-    mAuthor = issue["author"]["name"].toString();
-    mAssignee = issue["assignee"]["name"].toString();
-    mState = issue["state"].toString();
-    QVariant v = issue["labels"].toString();
-    QString s = v.toString();
-    mLabels.clear();
+    d->mUrl = issue["web_url"].toString();
+    d->mIssueID = issue["id"].toInteger();
+    d->mIssueIID = issue["iid"].toInteger();
+    d->mTitle = issue["title"].toString();
+    d->mDescription = issue["description"].toString();
+    d->mAuthor = issue["author"]["name"].toString();
+    d->mAssignee = issue["assignee"]["name"].toString();
+    d->mState = issue["state"].toString();
     for (const QJsonValueRef &value : issue["labels"].toArray()) {
         QString label = value.toString();
         if (!label.isEmpty()) {
-            mLabels.append(label);
+            d->mLabels.append(label);
         }
     }
-    mIssueType = issue["issue_type"].toString();
-    mCreatedAt = QDateTime::fromString(issue["created_at"].toString(), Qt::ISODate);
-    mUpdatedAt = QDateTime::fromString(issue["updated_at"].toString(), Qt::ISODate);
-    mNotesCount = issue["user_notes_count"].toInt();
+    d->mIssueType = issue["issue_type"].toString();
+    d->mCreatedAt = QDateTime::fromString(issue["created_at"].toString(), Qt::ISODate);
+    d->mUpdatedAt = QDateTime::fromString(issue["updated_at"].toString(), Qt::ISODate);
+    d->mNotesCount = issue["user_notes_count"].toInt();
+}
+
+Issue::Issue(const Issue &other) = default;
+Issue::Issue(Issue &&other) noexcept = default;
+Issue::~Issue() = default;
+Issue &Issue::operator=(const Issue &other) = default;
+Issue &Issue::operator=(Issue &&other) noexcept = default;
+
+Issue Issue::fromGraphQL(const QJsonObject &node)
+{
+    Issue issue;
+    IssueData *d = issue.d.data();
+    d->mUrl = node["webUrl"].toString();
+    // The global ID has the form "gid://gitlab/Issue/<id>"
+    d->mIssueID = node["id"].toString().section('/', -1).toInt();
+    d->mIssueIID = node["iid"].toString().toInt();
+    d->mTitle = node["title"].toString();
+    d->mDescription = node["description"].toString();
+    d->mAuthor = node["author"]["name"].toString();
+    const QJsonArray assignees = node["assignees"]["nodes"].toArray();
+    if (!assignees.isEmpty()) {
+        d->mAssignee = assignees.first()["name"].toString();
+    }
+    d->mState = node["state"].toString();
+    for (const QJsonValue &value : node["labels"]["nodes"].toArray()) {
+        const QString label = value["title"].toString();
+        if (!label.isEmpty()) {
+            d->mLabels.append(label);
+        }
+    }
+    d->mIssueType = node["type"].toString().toLower();
+    d->mCreatedAt = QDateTime::fromString(node["createdAt"].toString(), Qt::ISODate);
+    d->mUpdatedAt = QDateTime::fromString(node["updatedAt"].toString(), Qt::ISODate);
+    d->mNotesCount = node["userNotesCount"].toInt();
+    return issue;
+}
+
+QUrl Issue::url() const
+{
+    return d->mUrl;
+}
+
+void Issue::setUrl(const QUrl &url)
+{
+    d->mUrl = url;
+}
+
+int Issue::issueID() const
+{
+    return d->mIssueID;
+}
+
+void Issue::setIssueID(int id)
+{
+    d->mIssueID = id;
+}
+
+int Issue::issueIID() const
+{
+    return d->mIssueIID;
+}
+
+void Issue::setIssueIID(int iid)
+{
+    d->mIssueIID = iid;
+}
+
+QString Issue::title() const
+{
+    return d->mTitle;
+}
+
+void Issue::setTitle(const QString &title)
+{
+    d->mTitle = title;
+}
+
+QString Issue::description() const
+{
+    return d->mDescription;
+}
+
+void Issue::setDescription(const QString &description)
+{
+    d->mDescription = description;
+}
+
+QString Issue::author() const
+{
+    return d->mAuthor;
+}
+
+void Issue::setAuthor(const QString &author)
+{
+    d->mAuthor = author;
+}
+
+QString Issue::assignee() const
+{
+    return d->mAssignee;
+}
+
+void Issue::setAssignee(const QString &assignee)
+{
+    d->mAssignee = assignee;
+}
+
+QString Issue::state() const
+{
+    return d->mState;
+}
+
+void Issue::setState(const QString &state)
+{
+    d->mState = state;
+}
+
+QString Issue::stateEvent() const
+{
+    return d->mState_event;
+}
+
+void Issue::setStateEvent(const QString &stateEvent)
+{
+    d->mState_event = stateEvent;
+}
+
+QStringList Issue::labels() const
+{
+    return d->mLabels;
+}
+
+void Issue::setLabels(const QStringList &labels)
+{
+    d->mLabels = labels;
+}
+
+QString Issue::issueType() const
+{
+    return d->mIssueType;
+}
+
+void Issue::setIssueType(const QString &issueType)
+{
+    d->mIssueType = issueType;
+}
+
+QDateTime Issue::createdAt() const
+{
+    return d->mCreatedAt;
+}
+
+void Issue::setCreatedAt(const QDateTime &createdAt)
+{
+    d->mCreatedAt = createdAt;
+}
+
+QDateTime Issue::updatedAt() const
+{
+    return d->mUpdatedAt;
+}
+
+void Issue::setUpdatedAt(const QDateTime &updatedAt)
+{
+    d->mUpdatedAt = updatedAt;
+}
+
+int Issue::notesCount() const
+{
+    return d->mNotesCount;
+}
+
+void Issue::setNotesCount(int count)
+{
+    d->mNotesCount = count;
+}
+
+QDataStream &gitlab::operator<<(QDataStream &stream, const Issue &issue)
+{
+    stream << issue.url() << issue.issueID() << issue.issueIID() << issue.title() << issue.description()
+           << issue.author() << issue.assignee() << issue.state() << issue.labels() << issue.issueType()
+           << issue.createdAt() << issue.updatedAt() << issue.notesCount();
+    return stream;
+}
+
+QDataStream &gitlab::operator>>(QDataStream &stream, Issue &issue)
+{
+    IssueData *d = issue.d.data();
+    stream >> d->mUrl >> d->mIssueID >> d->mIssueIID >> d->mTitle >> d->mDescription >> d->mAuthor >> d->mAssignee
+            >> d->mState >> d->mLabels >> d->mIssueType >> d->mCreatedAt >> d->mUpdatedAt >> d->mNotesCount;
+    return stream;
 }
@@ -2,34 +2,75 @@
 
 #include "QGitlabAPI_global.h"
 
+#include <QDataStream>
 #include <QDateTime>
 #include <QJsonObject>
+#include <QSharedDataPointer>
 #include <QStringList>
+#include <QUrl>
 
 namespace gitlab {
 
+class IssueData;
+
 /**
  * @brief The Issue class holds data for a single issue
+ *
+ * The data is implicitly shared. Copies of an issue (in the lists of the client, the cache and the converters) all
+ * reference the same data, until one of them is changed.
  */
 class QGITLABAPI_EXPORT Issue
 {
 public:
+    Issue();
     Issue(const QJsonObject &issue);
+    Issue(const Issue &other);
+    Issue(Issue &&other) noexcept;
+    ~Issue();
+    Issue &operator=(const Issue &other);
+    Issue &operator=(Issue &&other) noexcept;
+
+    /**
+     * @brief fromGraphQL creates an issue from an issue node of the GitLab GraphQL API
+     */
+    static Issue fromGraphQL(const QJsonObject &node);
+
+    QUrl url() const; /// Web page of the issue
+    void setUrl(const QUrl &url);
+    int issueID() const; /// unique ID for the whole server
+    void setIssueID(int id);
+    int issueIID() const; /// unique ID within it's project
+    void setIssueIID(int iid);
+    QString title() const;
+    void setTitle(const QString &title);
+    QString description() const;
+    void setDescription(const QString &description);
+    QString author() const;
+    void setAuthor(const QString &author);
+    QString assignee() const;
+    void setAssignee(const QString &assignee);
+    QString state() const;
+    void setState(const QString &state);
+    QString stateEvent() const; /// @note should that be part of this class?
+    void setStateEvent(const QString &stateEvent);
+    QStringList labels() const;
+    void setLabels(const QStringList &labels);
+    QString issueType() const;
+    void setIssueType(const QString &issueType);
+    QDateTime createdAt() const;
+    void setCreatedAt(const QDateTime &createdAt);
+    QDateTime updatedAt() const;
+    void setUpdatedAt(const QDateTime &updatedAt);
+    int notesCount() const;
+    void setNotesCount(int count);
 
-    QUrl mUrl; // Web page of the issue
-    int mIssueID; /// unique ID for the whole server
-    int mIssueIID; /// unique ID within it's project
-    QString mTitle;
-    QString mDescription;
-    QString mAuthor;
-    QString mAssignee;
-    QString mState;
-    QString mState_event; /// @note should that be part of this class?
-    QStringList mLabels;
-    QString mIssueType;
-    QDateTime mCreatedAt;
-    QDateTime mUpdatedAt;
-    int mNotesCount;
+private:
+    QSharedDataPointer<IssueData> d;
+
+    friend QGITLABAPI_EXPORT QDataStream &operator>>(QDataStream &stream, Issue &issue);
 };
 
+QGITLABAPI_EXPORT QDataStream &operator<<(QDataStream &stream, const Issue &issue);
+QGITLABAPI_EXPORT QDataStream &operator>>(QDataStream &stream, Issue &issue);
+
 }
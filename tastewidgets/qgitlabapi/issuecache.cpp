@@ -0,0 +1,137 @@
+#include "issuecache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+using namespace gitlab;
+
+static const quint32 kMagic = 0x54494331; // "TIC1"
+static const quint32 kVersion = 1;
+
+void IssueCache::setKey(const QUrl &projectUrl, const QStringList &labels)
+{
+    QStringList sortedLabels = labels;
+    sortedLabels.sort();
+    const QString key = projectUrl.adjusted(QUrl::StripTrailingSlash).toString() + "|" + sortedLabels.join(",");
+    if (key != mKey) {
+        mKey = key;
+        mLabels = labels;
+        clear();
+    }
+}
+
+QString IssueCache::key() const
+{
+    return mKey;
+}
+
+bool IssueCache::load()
+{
+    clear();
+    if (mKey.isEmpty()) {
+        return false;
+    }
+
+    QFile file(fileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString key;
+    stream >> magic >> version;
+    if (magic != kMagic || version != kVersion) {
+        return false;
+    }
+    stream.setVersion(QDataStream::Qt_6_0);
+    QList<Issue> issues;
+    stream >> key >> issues;
+    if (stream.status() != QDataStream::Ok || key != mKey) {
+        qWarning() << "Invalid issue cache" << file.fileName();
+        return false;
+    }
+
+    updateIssues(issues);
+    return true;
+}
+
+bool IssueCache::save() const
+{
+    if (mKey.isEmpty()) {
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(fileName()).absolutePath());
+    QSaveFile file(fileName());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Unable to write the issue cache" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << kMagic << kVersion;
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << mKey << mIssues.values();
+    return file.commit();
+}
+
+void IssueCache::clear()
+{
+    mIssues.clear();
+    mLastUpdatedAt = QDateTime();
+}
+
+void IssueCache::updateIssues(const QList<Issue> &issues)
+{
+    for (const Issue &issue : issues) {
+        const QStringList labels = issue.labels();
+        const bool hasLabels = std::all_of(
+                mLabels.begin(), mLabels.end(), [&labels](const QString &label) { return labels.contains(label); });
+        if (issue.state() == "closed" || !hasLabels) {
+            mIssues.remove(issue.issueIID());
+        } else {
+            mIssues.insert(issue.issueIID(), issue);
+        }
+        if (!mLastUpdatedAt.isValid() || issue.updatedAt() > mLastUpdatedAt) {
+            mLastUpdatedAt = issue.updatedAt();
+        }
+    }
+}
+
+void IssueCache::removeIssues(const QList<int> &issueIIDs)
+{
+    for (int issueIID : issueIIDs) {
+        mIssues.remove(issueIID);
+    }
+}
+
+QList<Issue> IssueCache::issues() const
+{
+    return mIssues.values();
+}
+
+QList<int> IssueCache::issueIIDs() const
+{
+    return mIssues.keys();
+}
+
+QDateTime IssueCache::lastUpdatedAt() const
+{
+    return mLastUpdatedAt;
+}
+
+QString IssueCache::fileName() const
+{
+    const QByteArray hash = QCryptographicHash::hash(mKey.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/issues/" + hash + ".cache";
+}
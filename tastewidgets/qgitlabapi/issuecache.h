@@ -0,0 +1,63 @@
+#pragma once
+
+#include "issue.h"
+
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
+namespace gitlab {
+
+/**
+ * @brief The IssueCache class keeps the issues of one project and label filter on disk, so they can be shown
+ * right away at the next start of the application, while the server is asked for the changes in the background.
+ *
+ * The issues are stored with QDataStream in the cache location of the application (QStandardPaths).
+ */
+class IssueCache
+{
+public:
+    /**
+     * @brief setKey sets the server/project and labels the cached issues belong to.
+     * If the key changes, the issues in memory are dropped
+     */
+    void setKey(const QUrl &projectUrl, const QStringList &labels);
+    QString key() const;
+
+    /**
+     * @brief load reads the issues of the current key from disk
+     * @return false if there is no (valid) cache file
+     */
+    bool load();
+    /**
+     * @brief save writes the issues of the current key to disk
+     */
+    bool save() const;
+    void clear();
+
+    /**
+     * @brief updateIssues adds or replaces the given issues. Closed issues, and issues that don't have all labels of
+     * the key (anymore), are removed from the cache
+     */
+    void updateIssues(const QList<Issue> &issues);
+    void removeIssues(const QList<int> &issueIIDs);
+    QList<Issue> issues() const;
+    QList<int> issueIIDs() const;
+    /**
+     * @brief lastUpdatedAt returns the newest update time of all issues in the cache
+     */
+    QDateTime lastUpdatedAt() const;
+
+private:
+    QString fileName() const;
+
+    QString mKey;
+    QStringList mLabels;
+    QMap<int, Issue> mIssues; /// keyed by the issue IID
+    QDateTime mLastUpdatedAt;
+};
+
+}
@@ -2,6 +2,10 @@
 
 #include "urlcomposer.h"
 
+#include <QJsonArray>
+
+#include <algorithm>
+
 using namespace gitlab;
 
 QUrlQuery IssueRequestOptions::urlQuery() const
@@ -30,9 +34,64 @@ QUrlQuery IssueRequestOptions::urlQuery() const
     if (!mLabels.isEmpty()) {
         data["labels"] = mLabels.join(",");
     }
+    if (mUpdatedAfter.isValid()) {
+        data["updated_after"] = mUpdatedAfter.toUTC().toString(Qt::ISODateWithMs);
+    }
 
-    // Set the maximum number of issues being returned for this single request (gitlab max is 100)
-    data["per_page"] = 80;
+    if (mPerPage > 0) {
+        data["per_page"] = mPerPage;
+    }
+    if (mKeysetPagination) {
+        data["pagination"] = "keyset";
+        data.remove("page");
+    }
 
     return UrlComposer::setQuery(data);
 }
+
+QJsonObject IssueRequestOptions::graphQLQuery(const QString &projectPath, const QString &cursor) const
+{
+    static const QString query = QStringLiteral(
+            "query($fullPath: ID!, $first: Int, $after: String, $state: IssuableState, $labelName: [String],"
+            " $assigneeUsernames: [String!], $authorUsername: String, $iids: [String!], $updatedAfter: Time) {"
+            " project(fullPath: $fullPath) {"
+            " issues(first: $first, after: $after, state: $state, labelName: $labelName,"
+            " assigneeUsernames: $assigneeUsernames, authorUsername: $authorUsername, iids: $iids,"
+            " updatedAfter: $updatedAfter) {"
+            " pageInfo { hasNextPage endCursor }"
+            " nodes { id iid webUrl title description state type createdAt updatedAt userNotesCount"
+            " author { name } assignees(first: 1) { nodes { name } } labels { nodes { title } } }"
+            " } } }");
+
+    QJsonObject variables;
+    variables["fullPath"] = projectPath;
+    // Same maximum page size as the REST API
+    variables["first"] = std::clamp(mPerPage, 1, 100);
+    if (!cursor.isEmpty()) {
+        variables["after"] = cursor;
+    }
+    if (!mState.isEmpty()) {
+        variables["state"] = mState;
+    }
+    if (!mLabels.isEmpty()) {
+        variables["labelName"] = QJsonArray::fromStringList(mLabels);
+    }
+    if (!mAssignee.isEmpty()) {
+        variables["assigneeUsernames"] = QJsonArray { mAssignee };
+    }
+    if (!mAuthor.isEmpty()) {
+        variables["authorUsername"] = mAuthor;
+    }
+    if (!mIids.isEmpty()) {
+        QJsonArray iids;
+        for (int iid : mIids) {
+            iids.append(QString::number(iid));
+        }
+        variables["iids"] = iids;
+    }
+    if (mUpdatedAfter.isValid()) {
+        variables["updatedAfter"] = mUpdatedAfter.toUTC().toString(Qt::ISODateWithMs);
+    }
+
+    return QJsonObject { { "query", query }, { "variables", variables } };
+}
@@ -2,6 +2,8 @@
 
 #include "requestoptions.h"
 
+#include <QDateTime>
+#include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QStringList>
@@ -25,11 +27,22 @@ public:
                          ///
     QString mScope = "all"; /// Return issues for the given scope: "created_by_me", "assigned_to_me" or "all".
     QString mState = "opened"; /// Return "all" issues or just those that are "opened" or "closed"
+    QDateTime mUpdatedAfter; /// If valid, only issues updated on or after that time are fetched
+    bool mAdaptivePageSize = false; /// If true, a small first page is fetched, and the size of the following pages
+                                    /// is picked from the size of the issues and the response time
 
     /**
      * @brief queryData Creates query data for the URL
      */
     QUrlQuery urlQuery() const override;
+
+    /**
+     * @brief graphQLQuery Creates the body of a request to the GraphQL API, fetching one page of issues.
+     * Only the fields used by gitlab::Issue are requested. The scope is not supported by the GraphQL API.
+     * @param projectPath full path of the project, like "group/project"
+     * @param cursor the end cursor of the previous page. Empty for the first page
+     */
+    QJsonObject graphQLQuery(const QString &projectPath, const QString &cursor) const;
 };
 
 }
@@ -0,0 +1,107 @@
+#include "jsonarraystreamparser.h"
+
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+using namespace gitlab;
+
+static bool isJsonWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+QList<QJsonObject> JsonArrayStreamParser::addData(const QByteArray &data)
+{
+    QList<QJsonObject> elements;
+    if (hasError() || mFinished) {
+        return elements;
+    }
+
+    mBuffer.append(data);
+    for (; mScanPos < mBuffer.size() && !hasError() && !mFinished; ++mScanPos) {
+        const char c = mBuffer.at(mScanPos);
+
+        if (!mStarted) {
+            if (c == '[') {
+                mStarted = true;
+            } else if (!isJsonWhitespace(c)) {
+                setError(QString("Expected '[' at the start of the document"));
+            }
+            continue;
+        }
+
+        if (mElementStart < 0) {
+            // Between two elements of the array
+            if (c == '{') {
+                mElementStart = mScanPos;
+                mDepth = 1;
+            } else if (c == ']') {
+                mFinished = true;
+            } else if (c != ',' && !isJsonWhitespace(c)) {
+                setError(QString("Unexpected character '%1' between array elements").arg(QChar(c)));
+            }
+            continue;
+        }
+
+        if (mInString) {
+            if (mEscaped) {
+                mEscaped = false;
+            } else if (c == '\\') {
+                mEscaped = true;
+            } else if (c == '"') {
+                mInString = false;
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            mInString = true;
+        } else if (c == '{' || c == '[') {
+            ++mDepth;
+        } else if (c == '}' || c == ']') {
+            --mDepth;
+            if (mDepth == 0) {
+                QJsonParseError jsonError;
+                const QJsonDocument element = QJsonDocument::fromJson(
+                        QByteArray::fromRawData(mBuffer.constData() + mElementStart, mScanPos - mElementStart + 1),
+                        &jsonError);
+                if (jsonError.error != QJsonParseError::NoError) {
+                    setError(jsonError.errorString());
+                } else {
+                    elements.append(element.object());
+                }
+                mElementStart = -1;
+            }
+        }
+    }
+
+    // Drop everything that was consumed already
+    const qsizetype consumed = mElementStart < 0 ? mScanPos : mElementStart;
+    mBuffer.remove(0, consumed);
+    mScanPos -= consumed;
+    if (mElementStart >= 0) {
+        mElementStart = 0;
+    }
+
+    return elements;
+}
+
+bool JsonArrayStreamParser::atEnd() const
+{
+    return mFinished;
+}
+
+bool JsonArrayStreamParser::hasError() const
+{
+    return !mError.isEmpty();
+}
+
+QString JsonArrayStreamParser::errorString() const
+{
+    return mError;
+}
+
+void JsonArrayStreamParser::setError(const QString &error)
+{
+    mError = error;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+namespace gitlab {
+
+/**
+ * @brief The JsonArrayStreamParser class splits a JSON array of objects, that arrives in chunks, into its elements.
+ *
+ * Each chunk can be passed as soon as it was received (for example on QNetworkReply::readyRead). Complete elements
+ * are parsed and returned right away, only the bytes of the element that is not complete yet are kept.
+ */
+class JsonArrayStreamParser
+{
+public:
+    /**
+     * @brief addData appends the next chunk of the document
+     * @return the objects that were completed by that chunk
+     */
+    QList<QJsonObject> addData(const QByteArray &data);
+
+    /**
+     * @brief atEnd returns true once the closing bracket of the array was read
+     */
+    bool atEnd() const;
+    bool hasError() const;
+    QString errorString() const;
+
+private:
+    void setError(const QString &error);
+
+    QByteArray mBuffer; /// not yet consumed part of the document
+    qsizetype mScanPos = 0; /// position in mBuffer up to which the data was scanned already
+    qsizetype mElementStart = -1; /// start of the current element in mBuffer, -1 between elements
+    int mDepth = 0; /// nesting level inside the current element
+    bool mInString = false;
+    bool mEscaped = false;
+    bool mStarted = false;
+    bool mFinished = false;
+    QString mError;
+};
+
+}
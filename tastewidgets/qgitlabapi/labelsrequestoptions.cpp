@@ -23,6 +23,13 @@ QUrlQuery LabelsRequestOptions::urlQuery() const
     } else {
         data["page"] = 1;
     }
+    if (mPerPage > 0) {
+        data["per_page"] = mPerPage;
+    }
+    if (mKeysetPagination) {
+        data["pagination"] = "keyset";
+        data.remove("page");
+    }
 
     return UrlComposer::setQuery(data);
 }
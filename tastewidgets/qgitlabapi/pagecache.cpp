@@ -0,0 +1,98 @@
+#include "pagecache.h"
+
+#include <QNetworkRequest>
+#include <QUrlQuery>
+
+using namespace gitlab;
+
+static const int kHttpNotModified = 304;
+
+void PageCache::addValidators(QNetworkRequest &request) const
+{
+    auto it = m_entries.constFind(request.url());
+    if (it == m_entries.constEnd()) {
+        return;
+    }
+
+    if (!it->eTag.isEmpty()) {
+        request.setRawHeader("If-None-Match", it->eTag);
+    }
+    if (!it->lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", it->lastModified);
+    }
+}
+
+void PageCache::storeLabels(QNetworkReply *reply, const QList<Label> &labels)
+{
+    if (Entry *cached = storeEntry(reply)) {
+        cached->labels = labels;
+    }
+}
+
+const PageCache::Entry *PageCache::entry(QNetworkReply *reply) const
+{
+    auto it = m_entries.constFind(reply->request().url());
+    if (it == m_entries.constEnd()) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+/*!
+ * Returns the header \a headerName of the reply that was stored for the url of the \a reply
+ */
+QByteArray PageCache::rawHeader(QNetworkReply *reply, const QByteArray &headerName) const
+{
+    const Entry *cached = entry(reply);
+    if (!cached) {
+        return {};
+    }
+
+    for (const QNetworkReply::RawHeaderPair &header : cached->headers) {
+        if (header.first.compare(headerName, Qt::CaseInsensitive) == 0) {
+            return header.second;
+        }
+    }
+    return {};
+}
+
+bool PageCache::isNotModified(QNetworkReply *reply)
+{
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == kHttpNotModified;
+}
+
+void PageCache::clear()
+{
+    m_entries.clear();
+}
+
+PageCache::Entry PageCache::entryOf(QNetworkReply *reply)
+{
+    Entry entry;
+    entry.eTag = reply->rawHeader("ETag");
+    entry.lastModified = reply->rawHeader("Last-Modified");
+    entry.headers = reply->rawHeaderPairs();
+    return entry;
+}
+
+void PageCache::insert(const QUrl &url, const Entry &entry)
+{
+    const bool hasValidators = !entry.eTag.isEmpty() || !entry.lastModified.isEmpty();
+    if (!hasValidators || QUrlQuery(url).hasQueryItem("updated_after")) {
+        m_entries.remove(url);
+    } else {
+        m_entries.insert(url, entry);
+    }
+}
+
+/*!
+ * Creates/updates the entry for the url of the \a reply. Returns nullptr if the server did not send any validator,
+ * so the page can't be revalidated anyways.
+ */
+PageCache::Entry *PageCache::storeEntry(QNetworkReply *reply)
+{
+    const QUrl url = reply->request().url();
+    insert(url, entryOf(reply));
+    auto it = m_entries.find(url);
+    return it == m_entries.end() ? nullptr : &(*it);
+}
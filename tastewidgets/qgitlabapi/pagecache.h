@@ -0,0 +1,68 @@
+#pragma once
+
+#include "issue.h"
+#include "label.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QNetworkReply>
+#include <QUrl>
+
+class QNetworkRequest;
+
+namespace gitlab {
+
+/**
+ * @brief The PageCache class remembers the validators (ETag / Last-Modified) and the parsed content of fetched
+ * pages of issues and labels.
+ * A page that is requested again is sent as conditional request. If the server replies with "304 Not Modified",
+ * the stored content is used, without downloading or parsing the page again.
+ */
+class PageCache
+{
+public:
+    struct Entry {
+        QByteArray eTag;
+        QByteArray lastModified;
+        QList<QNetworkReply::RawHeaderPair> headers; /// headers of the full reply (pagination data)
+        QList<Issue> issues;
+        QList<Label> labels;
+    };
+
+    /**
+     * @brief addValidators adds the If-None-Match / If-Modified-Since headers, if the url is in the cache
+     */
+    void addValidators(QNetworkRequest &request) const;
+
+    void storeLabels(QNetworkReply *reply, const QList<Label> &labels);
+
+    /**
+     * @brief entryOf returns an entry with the validators and headers of the \a reply, but without content.
+     * It is used to store the content once it was parsed, when the reply does not exist anymore.
+     */
+    static Entry entryOf(QNetworkReply *reply);
+    /**
+     * @brief insert stores the \a entry for the \a url. Entries without any validator are removed instead.
+     * Urls with "updated_after" are not stored: every incremental fetch has its own time, so they are never requested
+     * again, and would only grow the cache
+     */
+    void insert(const QUrl &url, const Entry &entry);
+
+    /**
+     * @brief entry returns the cached data for the url of the reply, or nullptr if there is none
+     */
+    const Entry *entry(QNetworkReply *reply) const;
+    QByteArray rawHeader(QNetworkReply *reply, const QByteArray &headerName) const;
+
+    static bool isNotModified(QNetworkReply *reply);
+
+    void clear();
+
+private:
+    Entry *storeEntry(QNetworkReply *reply);
+
+    QHash<QUrl, Entry> m_entries;
+};
+
+}
@@ -0,0 +1,79 @@
+#include "projectidcache.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+using namespace gitlab;
+
+int ProjectIdCache::projectId(const QUrl &projectUrl) const
+{
+    load();
+    return mProjectIds.value(key(projectUrl), -1);
+}
+
+void ProjectIdCache::insert(const QUrl &projectUrl, int projectId)
+{
+    load();
+    if (mProjectIds.value(key(projectUrl), -1) == projectId) {
+        return;
+    }
+    mProjectIds.insert(key(projectUrl), projectId);
+    save();
+}
+
+void ProjectIdCache::remove(const QUrl &projectUrl)
+{
+    load();
+    if (mProjectIds.remove(key(projectUrl)) > 0) {
+        save();
+    }
+}
+
+QString ProjectIdCache::key(const QUrl &projectUrl)
+{
+    return projectUrl.adjusted(QUrl::StripTrailingSlash | QUrl::RemoveUserInfo).toString();
+}
+
+QString ProjectIdCache::fileName() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/gitlabprojects.cache";
+}
+
+void ProjectIdCache::load() const
+{
+    if (mLoaded) {
+        return;
+    }
+    mLoaded = true;
+
+    QFile file(fileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream >> mProjectIds;
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Invalid project ID cache" << file.fileName();
+        mProjectIds.clear();
+    }
+}
+
+void ProjectIdCache::save() const
+{
+    QDir().mkpath(QFileInfo(fileName()).absolutePath());
+    QSaveFile file(fileName());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Unable to write the project ID cache" << file.fileName() << file.errorString();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << mProjectIds;
+    file.commit();
+}
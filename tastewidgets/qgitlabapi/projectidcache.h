@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QUrl>
+
+namespace gitlab {
+
+/**
+ * @brief The ProjectIdCache class remembers the ID of projects by their URL across sessions.
+ * The data is stored in the cache location of the application (QStandardPaths).
+ */
+class ProjectIdCache
+{
+public:
+    /**
+     * @brief projectId returns the cached ID of the project, or -1 if the project is unknown
+     */
+    int projectId(const QUrl &projectUrl) const;
+    void insert(const QUrl &projectUrl, int projectId);
+    void remove(const QUrl &projectUrl);
+
+private:
+    static QString key(const QUrl &projectUrl);
+    QString fileName() const;
+    void load() const;
+    void save() const;
+
+    mutable bool mLoaded = false;
+    mutable QHash<QString, int> mProjectIds;
+};
+
+}
@@ -1,133 +1,247 @@
 #include "qgitlabclient.h"
 
+#include "contentdecoder.h"
 #include "issuerequestoptions.h"
+#include "jsonarraystreamparser.h"
 #include "labelsrequestoptions.h"
 
 #include <QDebug>
-#include <QDir>
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QRandomGenerator>
+#include <QSslConfiguration>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QThreadPool>
 #include <QUrl>
 #include <QUrlQuery>
+#include <QtConcurrent>
 
 #define WRN qWarning() << Q_FUNC_INFO
 
 namespace gitlab {
 
 const QString kContentType = "application/x-www-form-urlencoded";
+const QString kJsonContentType = "application/json";
+const QByteArray kAcceptEncoding = "gzip, deflate"; /// encodings that ContentDecoder can read
 
-QGitlabClient::QGitlabClient() { }
+const int kMaxPerPage = 100; /// maximum page size of the gitlab API
+const int kAdaptiveFirstPageSize = 20; /// page size of the first page of an adaptive fetch
+const int kProbePage = 0; /// page number of the first page of an adaptive fetch
+const qint64 kMaxAdaptivePageBytes = 512 * 1024; /// pages of an adaptive fetch should not be bigger
+const qint64 kSlowPageMsecs = 1000; /// slower first pages are dominated by latency - use the biggest pages
+
+const int kRetryBaseDelayMsecs = 500; /// delay of the first retry, doubled for every following retry
+const int kRetryMaxDelayMsecs = 30000;
+const int kMinRateLimitReserve = 5; /// requests are spread out, when less requests are left of the rate limit
+
+const int kBatchWindow = 4; /// edits of one batch that are sent at the same time
+const int kBatchRetries = 2; /// number of retries of a failed edit of a batch
+
+QGitlabClient::QGitlabClient()
+{
+    m_throttleTimer.setSingleShot(true);
+    connect(&m_throttleTimer, &QTimer::timeout, this, &QGitlabClient::startQueuedRequests);
+}
 
 void QGitlabClient::setCredentials(const QString &url, const QString &token)
 {
     QUrl api_url(url);
     api_url.setPath("/api/v4");
+    if (api_url != mUrlComposer.baseURL() || token != mToken) {
+        m_pageCache.clear();
+        m_throttledUntil = 0;
+        m_throttleInterval = 0;
+    }
     mUrlComposer.setBaseURL(api_url.toString());
     mToken = token;
+    warmUpConnection();
 }
 
-bool QGitlabClient::requestIssues(const IssueRequestOptions &options)
+void QGitlabClient::setHttp2Enabled(bool enabled)
 {
-    if (isBusy()) {
-        return true;
+    m_http2Enabled = enabled;
+}
+
+bool QGitlabClient::http2Enabled() const
+{
+    return m_http2Enabled;
+}
+
+/*!
+ * Opens the connection to the server (including the TLS handshake), before the first request needs it
+ */
+void QGitlabClient::warmUpConnection()
+{
+    const QUrl baseUrl = mUrlComposer.baseURL();
+    if (baseUrl.host().isEmpty()) {
+        return;
     }
-    setBusy(true);
-    auto reply = sendRequest(QGitlabClient::GET, mUrlComposer.composeGetIssuesUrl(options.mProjectID, options));
-    connect(reply, &QNetworkReply::finished, [reply, options, this]() {
-        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
-            QJsonParseError jsonError;
-            auto replyContent = QJsonDocument::fromJson(reply->readAll(), &jsonError);
-            if (QJsonParseError::NoError != jsonError.error) {
-                const QString &errMsg = QString("ERROR: QGitlabClient::requestIssues: Parsing json data: %1, #%2")
-                                                .arg(jsonError.errorString())
-                                                .arg(jsonError.offset);
-                WRN << errMsg;
-                notifyError(reply, errMsg);
-                // TODO: setBusy(false); ?
-            } else {
-                QList<Issue> issues;
-                for (const QJsonValueRef &value : replyContent.array()) {
-                    issues.push_back(value.toObject());
-                }
-                Q_EMIT listOfIssues(issues);
-            }
 
-            if (!requestNextPage(reply, options)) {
-                setBusy(false);
-                Q_EMIT issueFetchingDone();
-            }
-        } else {
-            WRN << reply->error() << reply->errorString();
-            setBusy(false);
-            notifyError(reply, "QGitlabClient::requestIssues");
+    if (baseUrl.scheme() == "https") {
+#ifndef QT_NO_SSL
+        QSslConfiguration sslConfiguration = QSslConfiguration::defaultConfiguration();
+        if (m_http2Enabled) {
+            // Without ALPN the connection would not be usable for HTTP/2 requests
+            sslConfiguration.setAllowedNextProtocols(
+                    { QSslConfiguration::ALPNProtocolHTTP2, QSslConfiguration::NextProtocolHttp1_1 });
         }
-    });
-    return false;
+        mManager.connectToHostEncrypted(baseUrl.host(), baseUrl.port(443), sslConfiguration);
+#endif
+    } else {
+        mManager.connectToHost(baseUrl.host(), baseUrl.port(80));
+    }
 }
 
-bool QGitlabClient::editIssue(const int &projectID, const int &issueID, const Issue &newIssue)
+/*!
+ * State of one (multi page) issue fetch started by requestIssues
+ */
+struct QGitlabClient::IssuesFetch {
+    int requestId = -1;
+    IssueRequestOptions options;
+    int totalPages = -1; /// -1 as long as the server did not report the number of pages
+    int nextPageToRequest = 0;
+    int nextPageToDeliver = 0;
+    int pagesInFlight = 0;
+    bool failed = false;
+    QMap<int, QList<Issue>> finishedPages; /// pages that arrived before their predecessors
+    int perPage = kMaxPerPage; /// page size of all pages but the first page of an adaptive fetch
+    int skipIssues = 0; /// issues at the start of page 1, that were already delivered with the first adaptive page
+    qint64 probeBytes = 0; /// size of the first page of an adaptive fetch
+    qint64 probeMsecs = 0; /// time it took to fetch the first page of an adaptive fetch
+};
+
+/*!
+ * State of a batch of issue edits started by editIssues, closeIssues or relabelIssues
+ */
+struct QGitlabClient::IssuesBatch {
+    struct Item {
+        int issueID = -1;
+        QUrl url;
+        int attempt = 0;
+    };
+
+    int requestId = -1;
+    QList<Item> pending; /// edits that were not sent yet, or have to be retried
+    int running = 0;
+    int waiting = 0; /// edits waiting for their retry
+    QList<int> failedIssueIDs;
+};
+
+/*!
+ * Issues of one page, parsed while the page is downloaded.
+ * The chunks are parsed one after the other in the thread pool. The parser and the issues must not be touched by
+ * the thread of the client, before \a parsing is finished.
+ */
+struct QGitlabClient::IssuesPageStream {
+    JsonArrayStreamParser parser;
+    QList<Issue> issues;
+    qint64 bytes = 0;
+    QElapsedTimer timer;
+    qint64 startedAt = -1; /// RequestMetrics::now() when the timer was started
+    QFuture<void> parsing; /// parsing of the last chunk that arrived
+    qint64 parseUsecs = 0; /// time spent parsing all chunks
+    qint64 parsedAt = 0; /// end of the last parsed chunk, relative to the timer (usecs)
+};
+
+/*!
+ * Pagination headers of a page of issues. Those are read when the page arrived, as the reply is gone once the page
+ * was parsed.
+ */
+struct QGitlabClient::PageHeaders {
+    int totalPages = -1; /// x-total-pages
+    int nextPage = -1; /// x-next-page
+    QUrl nextLink; /// "next" link of the Link header
+    int totalItems = -1; /// x-total
+};
+
+/*!
+ * Issues of a GraphQL page, parsed in the thread pool
+ */
+struct QGitlabClient::GraphQLPage {
+    QList<Issue> issues;
+    QString errorString;
+    bool hasNextPage = false;
+    QString endCursor;
+    qint64 parseStart = 0; /// relative to the scheduling of the parsing (usecs)
+    qint64 parseEnd = 0;
+};
+
+int QGitlabClient::requestIssues(const IssueRequestOptions &options)
 {
-    if (isBusy()) {
-        return true;
+    auto fetch = std::make_shared<IssuesFetch>();
+    fetch->requestId = createRequestId();
+    fetch->options = options;
+    if (m_fetchBackend == GraphQLBackend && m_projectPaths.contains(options.mProjectID)) {
+        fetch->nextPageToDeliver = 1;
+        requestGraphQLIssuesPage(fetch, 1, QString());
+        return fetch->requestId;
+    }
+
+    fetch->perPage = options.mPerPage > 0 ? options.mPerPage : kMaxPerPage;
+    if (options.mAdaptivePageSize && !options.mKeysetPagination && options.mPage <= 1) {
+        fetch->nextPageToDeliver = kProbePage;
+        requestIssuesPage(fetch, kProbePage);
+        return fetch->requestId;
     }
-    setBusy(true);
-    auto reply = sendRequest(QGitlabClient::PUT,
-            mUrlComposer.composeEditIssueUrl(projectID, newIssue.mIssueIID, newIssue.mTitle, newIssue.mDescription,
-                    newIssue.mAssignee, newIssue.mState_event, newIssue.mLabels));
-    connect(reply, &QNetworkReply::finished, [reply, this]() {
-        setBusy(false);
+
+    const int firstPage = std::max(1, options.mPage);
+    fetch->nextPageToRequest = firstPage + 1;
+    fetch->nextPageToDeliver = firstPage;
+    requestIssuesPage(fetch, firstPage);
+    return fetch->requestId;
+}
+
+int QGitlabClient::editIssue(const int &projectID, const int &issueID, const Issue &newIssue)
+{
+    const int requestId = createRequestId();
+    enqueueRequest(requestId, HighPriority, QGitlabClient::PUT,
+            mUrlComposer.composeEditIssueUrl(projectID, newIssue.issueIID(), newIssue.title(), newIssue.description(),
+                    newIssue.assignee(), newIssue.stateEvent(), newIssue.labels()),
+            [this](QNetworkReply *reply) {
         if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
             WRN << reply->error() << reply->errorString();
             notifyError(reply, "QGitlabClient::editIssue");
         }
     });
-    return false;
+    return requestId;
 }
 
-bool QGitlabClient::createIssue(
+int QGitlabClient::createIssue(
         const int &projectID, const QString &title, const QString &description, const QStringList &labels)
 {
-    if (isBusy()) {
-        return true;
-    }
-    setBusy(true);
-    auto reply = sendRequest(
-            QGitlabClient::POST, mUrlComposer.composeCreateIssueUrl(projectID, title, description, labels, ""));
-    connect(reply, &QNetworkReply::finished, [reply, this]() {
-        setBusy(false);
+    const int requestId = createRequestId();
+    enqueueRequest(requestId, HighPriority, QGitlabClient::POST,
+            mUrlComposer.composeCreateIssueUrl(projectID, title, description, labels, ""),
+            [this](QNetworkReply *reply) {
         if (reply->error() != QNetworkReply::NoError) {
             WRN << reply->error() << reply->errorString();
             notifyError(reply, "QGitlabClient::createIssue");
 
         } else {
-            QJsonDocument replyContent = QJsonDocument::fromJson(reply->readAll());
+            QJsonDocument replyContent = QJsonDocument::fromJson(readReply(reply));
             QJsonObject jobj = replyContent.object();
             Issue issue(jobj);
             Q_EMIT issueCreated(issue);
         }
     });
-    return false;
+    return requestId;
 }
 
-bool QGitlabClient::closeIssue(const int &projectID, const int &issueID)
+int QGitlabClient::closeIssue(const int &projectID, const int &issueID)
 {
-    if (isBusy()) {
-        return true;
-    }
-    setBusy(true);
+    const int requestId = createRequestId();
     static const QString &title = QString();
     static const QString &description = QString();
     static const QString &assignee = QString();
     const QString state_event = "close";
     const QStringList &labels = QStringList();
-    auto reply = sendRequest(QGitlabClient::PUT,
-            mUrlComposer.composeEditIssueUrl(projectID, issueID, title, description, assignee, state_event, labels));
-    connect(reply, &QNetworkReply::finished, [reply, this]() {
-        setBusy(false);
+    enqueueRequest(requestId, HighPriority, QGitlabClient::PUT,
+            mUrlComposer.composeEditIssueUrl(projectID, issueID, title, description, assignee, state_event, labels),
+            [this](QNetworkReply *reply) {
         if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
             WRN << reply->error() << reply->errorString();
             notifyError(reply, "QGitlabClient::closeIssue");
@@ -136,33 +250,152 @@ bool QGitlabClient::closeIssue(const int &projectID, const int &issueID)
             Q_EMIT issueClosed();
         }
     });
-    return false;
+    return requestId;
 }
 
-bool QGitlabClient::requestListofLabels(const LabelsRequestOptions &options)
+int QGitlabClient::editIssues(const int &projectID, const QList<Issue> &issues)
 {
-    if (isBusy()) {
-        return true;
+    QList<QPair<int, QUrl>> edits;
+    for (const Issue &issue : issues) {
+        edits.append({ issue.issueIID(),
+                mUrlComposer.composeEditIssueUrl(projectID, issue.issueIID(), issue.title(), issue.description(),
+                        issue.assignee(), issue.stateEvent(), issue.labels()) });
     }
-    setBusy(true);
-    auto reply = sendRequest(QGitlabClient::GET, mUrlComposer.composeProjectLabelsUrl(options));
-    connect(reply, &QNetworkReply::finished, [reply, this, options]() {
-        setBusy(false);
-        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
-            QJsonParseError jsonError;
-            auto replyContent = QJsonDocument::fromJson(reply->readAll(), &jsonError);
-            if (QJsonParseError::NoError != jsonError.error) {
-                WRN << "ERROR: Parsing json data: " << jsonError.errorString();
-                notifyError(reply, "QGitlabClient::requestListofLabels");
+    return startBatch(edits);
+}
+
+int QGitlabClient::closeIssues(const int &projectID, const QList<int> &issueIDs)
+{
+    QList<QPair<int, QUrl>> edits;
+    for (int issueID : issueIDs) {
+        edits.append({ issueID,
+                mUrlComposer.composeEditIssueUrl(projectID, issueID, QString(), QString(), QString(), "close") });
+    }
+    return startBatch(edits);
+}
+
+int QGitlabClient::relabelIssues(
+        const int &projectID, const QList<int> &issueIDs, const QStringList &addLabels, const QStringList &removeLabels)
+{
+    QList<QPair<int, QUrl>> edits;
+    for (int issueID : issueIDs) {
+        edits.append({ issueID, mUrlComposer.composeRelabelIssueUrl(projectID, issueID, addLabels, removeLabels) });
+    }
+    return startBatch(edits);
+}
+
+int QGitlabClient::startBatch(const QList<QPair<int, QUrl>> &edits)
+{
+    auto batch = std::make_shared<IssuesBatch>();
+    batch->requestId = createRequestId();
+    for (const auto &edit : edits) {
+        batch->pending.append({ edit.first, edit.second, 0 });
+    }
+    if (batch->pending.isEmpty()) {
+        // Report it after the caller got the ID
+        QMetaObject::invokeMethod(
+                this, [this, batchId = batch->requestId]() { Q_EMIT batchFinished(batchId, {}); },
+                Qt::QueuedConnection);
+        return batch->requestId;
+    }
+
+    m_batches.insert(batch->requestId, batch);
+    sendBatchItems(batch);
+    return batch->requestId;
+}
+
+/*!
+ * Queues the next edits of the batch. Only a few edits of a batch are queued at the same time, so other requests
+ * don't have to wait for a big batch to finish.
+ */
+void QGitlabClient::sendBatchItems(const std::shared_ptr<IssuesBatch> &batch)
+{
+    while (batch->running < kBatchWindow && !batch->pending.isEmpty()) {
+        const IssuesBatch::Item item = batch->pending.takeFirst();
+        ++batch->running;
+        enqueueRequest(batch->requestId, HighPriority, QGitlabClient::PUT, item.url,
+                [this, batch, item](QNetworkReply *reply) {
+            handleBatchItem(reply, batch, item.issueID, item.url, item.attempt);
+        });
+    }
+
+    if (batch->running == 0 && batch->waiting == 0 && batch->pending.isEmpty()
+            && m_batches.remove(batch->requestId) > 0) {
+        Q_EMIT batchFinished(batch->requestId, batch->failedIssueIDs);
+    }
+}
+
+void QGitlabClient::handleBatchItem(
+        QNetworkReply *reply, const std::shared_ptr<IssuesBatch> &batch, int issueID, const QUrl &url, int attempt)
+{
+    --batch->running;
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode == 200) {
+        Q_EMIT batchItemFinished(batch->requestId, issueID, true);
+    } else {
+        // Client errors other than rate limiting will fail again
+        const bool retryable = statusCode == 0 || statusCode == 429 || statusCode >= 500;
+        if (retryable && attempt < kBatchRetries) {
+            // Same backoff and rate limiting as for the retries of GET requests
+            const int delay = retryDelay(reply, attempt);
+            WRN << "Retrying edit of issue" << issueID << "in" << delay << "ms. Status:" << statusCode
+                << reply->errorString();
+            if (statusCode == 429) {
+                throttle(delay);
+            }
+            ++batch->waiting;
+            startRetryTimer(batch->requestId, delay, [this, batch, issueID, url, attempt]() {
+                --batch->waiting;
+                batch->pending.append({ issueID, url, attempt + 1 });
+                sendBatchItems(batch);
+            });
+        } else {
+            WRN << "Editing issue" << issueID << "failed:" << statusCode << reply->errorString();
+            batch->failedIssueIDs.append(issueID);
+            Q_EMIT batchItemFinished(batch->requestId, issueID, false);
+        }
+    }
+
+    sendBatchItems(batch);
+}
+
+int QGitlabClient::requestListofLabels(const LabelsRequestOptions &options)
+{
+    const int requestId = createRequestId();
+    requestLabelsPage(requestId, options);
+    return requestId;
+}
+
+/*!
+ * Requests one page of labels. If \a url is not set, the url of the page is composed from the \a options
+ */
+void QGitlabClient::requestLabelsPage(int requestId, const LabelsRequestOptions &options, const QUrl &url)
+{
+    enqueueRequest(requestId, LowPriority, QGitlabClient::GET,
+            url.isValid() ? url : mUrlComposer.composeProjectLabelsUrl(options),
+            [this, requestId, options](QNetworkReply *reply) {
+        const PageCache::Entry *cached = PageCache::isNotModified(reply) ? m_pageCache.entry(reply) : nullptr;
+        if (cached || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
+            if (cached) {
+                const QList<Label> labels = cached->labels;
+                Q_EMIT listOfLabels(labels);
             } else {
-                QList<Label> labels;
-                for (const QJsonValueRef &label : replyContent.array()) {
-                    labels.push_back(Label(label.toObject()));
+                QJsonParseError jsonError;
+                auto replyContent = QJsonDocument::fromJson(readReply(reply), &jsonError);
+                if (QJsonParseError::NoError != jsonError.error) {
+                    WRN << "ERROR: Parsing json data: " << jsonError.errorString();
+                    notifyError(reply, "QGitlabClient::requestListofLabels");
+                } else {
+                    QList<Label> labels;
+                    for (const QJsonValueRef &label : replyContent.array()) {
+                        labels.push_back(Label(label.toObject()));
+                    }
+                    m_pageCache.storeLabels(reply, labels);
+                    Q_EMIT listOfLabels(labels);
                 }
-                Q_EMIT listOfLabels(labels);
             }
-            if (!requestNextPage(reply, options)) {
-                setBusy(false);
+            if (!requestNextPage(requestId, reply, options)) {
                 Q_EMIT labelsFetchingDone();
             }
         } else {
@@ -170,23 +403,44 @@ bool QGitlabClient::requestListofLabels(const LabelsRequestOptions &options)
             notifyError(reply, "QGitlabClient::requestListofLabels");
         }
     });
-    return false;
 }
 
-bool QGitlabClient::requestProjectId(const QUrl &projectUrl)
+int QGitlabClient::requestProjectId(const QUrl &projectUrl)
 {
-    if (isBusy()) {
-        return true;
+    const int requestId = createRequestId();
+
+    QString projectPath = projectUrl.path(QUrl::FullyDecoded);
+    if (projectPath.endsWith(".git")) {
+        projectPath.chop(4);
+    }
+    while (projectPath.endsWith('/')) {
+        projectPath.chop(1);
+    }
+    while (projectPath.startsWith('/')) {
+        projectPath.remove(0, 1);
+    }
+
+    // Report the ID known from an earlier session right away, and revalidate it with the server
+    const int cachedProjectID = mProjectIdCache.projectId(projectUrl);
+    if (cachedProjectID >= 0) {
+        m_projectPaths.insert(cachedProjectID, projectPath);
+        QMetaObject::invokeMethod(
+                this,
+                [this, requestId, cachedProjectID]() {
+                    if (isRequestPending(requestId)) {
+                        Q_EMIT requestedProjectID(cachedProjectID);
+                    }
+                },
+                Qt::QueuedConnection);
     }
-    setBusy(true);
-    auto projectName = QDir(QUrl(projectUrl).path()).dirName();
-    auto reply = sendRequest(QGitlabClient::GET, mUrlComposer.composeProjectUrl(projectName));
-    connect(reply, &QNetworkReply::finished, [reply, projectUrl, this]() {
-        setBusy(false);
+
+    enqueueRequest(requestId, NormalPriority, QGitlabClient::GET, mUrlComposer.composeProjectByPathUrl(projectPath),
+            [projectUrl, cachedProjectID, this](QNetworkReply *reply) {
+        const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
         int projectID = -1;
-        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
+        if (statusCode == 200) {
             QJsonParseError jsonError;
-            auto replyContent = QJsonDocument::fromJson(reply->readAll(), &jsonError);
+            auto replyContent = QJsonDocument::fromJson(readReply(reply), &jsonError);
             if (QJsonParseError::NoError != jsonError.error) {
                 WRN << "ERROR: Parsing json data: " << jsonError.errorString();
                 const QString &errMsg = QString("ERROR: QGitlabClient::requestProjectId: Parsing json data: %1, #%2")
@@ -195,52 +449,53 @@ bool QGitlabClient::requestProjectId(const QUrl &projectUrl)
                 WRN << errMsg;
                 notifyError(reply, errMsg);
             } else {
-                auto content = replyContent.array();
-                if (!content.isEmpty()) {
-                    static const auto ID = "id";
-                    for (const auto item : content) {
-                        const QString projectUrlStr(projectUrl.toString());
-                        const auto &itemObj = item.toObject();
-                        const bool objOk = !itemObj.isEmpty() && itemObj.contains("web_url") && itemObj.contains("id");
-                        if (objOk && itemObj.value("web_url").toString() == projectUrlStr) {
-                            projectID = itemObj.value("id").toInteger();
-                            break;
-                        }
-                    }
+                const QJsonObject project = replyContent.object();
+                if (project.contains("id")) {
+                    projectID = project.value("id").toInteger();
+                    m_projectPaths.insert(projectID, project.value("path_with_namespace").toString());
                 }
             }
+        } else if (statusCode == 404) {
+            WRN << "Project not found:" << projectUrl;
+        } else if (cachedProjectID >= 0) {
+            // Keep using the cached ID, when the server could not be asked. Nothing failed for the user
+            WRN << "Keeping the cached project ID" << cachedProjectID << "- response" << statusCode
+                << reply->errorString();
+            return;
         } else {
             WRN << reply->error() << reply->errorString();
-            notifyError(reply,
-                    QString("Response %1 != 200")
-                            .arg(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()));
+            notifyError(reply, QString("Response %1 != 200").arg(statusCode));
+        }
+
+        if (projectID >= 0) {
+            mProjectIdCache.insert(projectUrl, projectID);
+        } else {
+            mProjectIdCache.remove(projectUrl);
+        }
+        if (projectID != cachedProjectID) {
+            Q_EMIT requestedProjectID(projectID);
         }
-        Q_EMIT requestedProjectID(projectID);
     });
-    return false;
+    return requestId;
 }
 
 /*!
- * Returns true, if data is currently fetched from the server
+ * Returns true, if data is currently fetched from the server, or requests are waiting to be sent
  */
 bool QGitlabClient::isBusy() const
 {
     return m_busy;
 }
 
-bool QGitlabClient::requestGroupID(const QString &groupName)
+int QGitlabClient::requestGroupID(const QString &groupName)
 {
-    if (isBusy()) {
-        return true;
-    }
-    setBusy(true);
-    auto reply = sendRequest(QGitlabClient::GET, mUrlComposer.composeProjectUrl(groupName));
-    connect(reply, &QNetworkReply::finished, [reply, this]() {
-        setBusy(false);
+    const int requestId = createRequestId();
+    enqueueRequest(requestId, NormalPriority, QGitlabClient::GET, mUrlComposer.composeProjectUrl(groupName),
+            [this](QNetworkReply *reply) {
         QString groupID = QString("-1");
         if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
             QJsonParseError jsonError;
-            auto replyContent = QJsonDocument::fromJson(reply->readAll(), &jsonError);
+            auto replyContent = QJsonDocument::fromJson(readReply(reply), &jsonError);
             if (QJsonParseError::NoError != jsonError.error) {
                 WRN << "ERROR: Parsing json data: " << jsonError.errorString();
                 const QString &errMsg = QString("ERROR: QGitlabClient::requestGroupId: Parsing json data: %1, #%2")
@@ -271,37 +526,432 @@ bool QGitlabClient::requestGroupID(const QString &groupName)
         }
         Q_EMIT requestedGroupID(groupID);
     });
-    return false;
+    return requestId;
 }
 
-bool QGitlabClient::createProject(const QString &projectName, const QString &groupID)
+int QGitlabClient::createProject(const QString &projectName, const QString &groupID)
 {
-    if (isBusy()) {
-        return true;
-    }
-    setBusy(true);
-    auto reply = sendRequest(QGitlabClient::POST, mUrlComposer.composeCreateProjectUrl(projectName, groupID));
-    connect(reply, &QNetworkReply::finished, [reply, this, &projectName]() {
-        setBusy(false);
+    const int requestId = createRequestId();
+    enqueueRequest(requestId, HighPriority, QGitlabClient::POST,
+            mUrlComposer.composeCreateProjectUrl(projectName, groupID), [this, projectName](QNetworkReply *reply) {
         if (reply->error() != QNetworkReply::NoError) {
             WRN << reply->error() << reply->errorString();
             notifyError(reply, "QGitlabClient::createProject");
 
         } else {
-            QJsonDocument replyContent = QJsonDocument::fromJson(reply->readAll());
+            QJsonDocument replyContent = QJsonDocument::fromJson(readReply(reply));
             QJsonObject jobj = replyContent.object();
             Issue issue(jobj);
             Q_EMIT projectCreated(projectName);
         }
     });
-    return false;
+    return requestId;
+}
+
+bool QGitlabClient::cancelRequest(int requestId)
+{
+    const bool batchCancelled = m_batches.remove(requestId) > 0;
+    const bool parsingCancelled = m_parsingPages.remove(requestId) > 0;
+    const QList<QTimer *> retryTimers = m_retryTimers.values(requestId);
+    for (QTimer *timer : retryTimers) {
+        timer->stop();
+        timer->deleteLater();
+    }
+    m_retryTimers.remove(requestId);
+    const qsizetype queued = m_queue.removeIf([requestId](const QueuedRequest &request) {
+        return request.requestId == requestId;
+    });
+
+    const QList<QNetworkReply *> replies = m_runningRequests.keys(requestId);
+    for (QNetworkReply *reply : replies) {
+        // Removed before the abort, so the finished handler drops the reply
+        m_runningRequests.remove(reply);
+        reply->abort();
+    }
+
+    startQueuedRequests();
+    updateBusyState();
+    return batchCancelled || parsingCancelled || !retryTimers.isEmpty() || queued > 0 || !replies.isEmpty();
+}
+
+void QGitlabClient::setMaxConcurrentRequests(int requests)
+{
+    m_maxConcurrentRequests = std::max(1, requests);
+    startQueuedRequests();
+}
+
+int QGitlabClient::maxConcurrentRequests() const
+{
+    return m_maxConcurrentRequests;
+}
+
+/*!
+ * Returns true if the request is queued, running, waiting for a retry or its pages are parsed - so it was not
+ * cancelled or finished yet
+ */
+bool QGitlabClient::isRequestPending(int requestId) const
+{
+    return m_retryTimers.contains(requestId) || m_parsingPages.contains(requestId)
+            || std::any_of(m_runningRequests.cbegin(), m_runningRequests.cend(),
+                    [requestId](int id) { return id == requestId; })
+            || std::any_of(m_queue.cbegin(), m_queue.cend(),
+                    [requestId](const QueuedRequest &request) { return request.requestId == requestId; });
+}
+
+void QGitlabClient::setMaxRetries(int retries)
+{
+    m_maxRetries = std::max(0, retries);
+}
+
+int QGitlabClient::maxRetries() const
+{
+    return m_maxRetries;
+}
+
+int QGitlabClient::createRequestId()
+{
+    return ++m_lastRequestId;
+}
+
+/*!
+ * Queues a request. Requests are sorted by \a priority, and first in first out for the same priority.
+ * \a onFinished is called when the reply is finished - unless the request was cancelled.
+ * If set, \a onReadyRead is called whenever new data of the reply arrived.
+ */
+void QGitlabClient::enqueueRequest(int requestId, Priority priority, ReqType type, const QUrl &url,
+        const std::function<void(QNetworkReply *)> &onFinished, const std::function<void(QNetworkReply *)> &onReadyRead,
+        const QByteArray &jsonBody)
+{
+    insertIntoQueue(QueuedRequest { requestId, priority, type, url, onFinished, onReadyRead, jsonBody });
+    startQueuedRequests();
+    updateBusyState();
+}
+
+void QGitlabClient::insertIntoQueue(QueuedRequest request)
+{
+    request.queuedAt = m_metrics.now();
+    auto it = std::find_if(m_queue.begin(), m_queue.end(),
+            [&request](const QueuedRequest &queued) { return queued.priority < request.priority; });
+    m_queue.insert(it, request);
+}
+
+void QGitlabClient::startQueuedRequests()
+{
+    while (m_runningRequests.size() < m_maxConcurrentRequests && !m_queue.isEmpty()) {
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        if (m_throttledUntil > now) {
+            if (!m_throttleTimer.isActive()) {
+                m_throttleTimer.start(int(m_throttledUntil - now));
+            }
+            return;
+        }
+        if (m_throttleInterval > 0) {
+            m_throttledUntil = now + m_throttleInterval;
+        }
+
+        const QueuedRequest request = m_queue.takeFirst();
+        QNetworkReply *reply = sendRequest(request.type, request.url, request.body);
+        m_runningRequests.insert(reply, request.requestId);
+        traceReply(reply, request);
+        if (request.onReadyRead) {
+            connect(reply, &QNetworkReply::readyRead, this, [this, reply, onReadyRead = request.onReadyRead]() {
+                if (m_runningRequests.contains(reply)) {
+                    onReadyRead(reply);
+                }
+            });
+        }
+        connect(reply, &QNetworkReply::finished, this, [this, reply, request]() {
+            reply->deleteLater();
+            if (m_runningRequests.remove(reply) == 0) {
+                m_replyTransfers.remove(reply);
+                return; // cancelled
+            }
+            m_replyTransfers[reply].timing.finishedAt = m_metrics.now();
+            updateRateLimit(reply);
+            if (!retryRequest(reply, request)) {
+                request.onFinished(reply);
+            }
+            recordTransfer(reply, request);
+            startQueuedRequests();
+            updateBusyState();
+        });
+    }
+}
+
+void QGitlabClient::updateBusyState()
+{
+    setBusy(!m_queue.isEmpty() || !m_runningRequests.isEmpty() || !m_retryTimers.isEmpty()
+            || !m_parsingPages.isEmpty());
+}
+
+/*!
+ * Queues the request again after a delay, if it failed for a temporary reason (rate limited, overloaded server or
+ * lost connection). Only GET requests are retried, as sending them again has no side effects.
+ * \return true if the request will be retried
+ */
+bool QGitlabClient::retryRequest(QNetworkReply *reply, const QueuedRequest &request)
+{
+    if (request.type != QGitlabClient::GET || request.attempt >= m_maxRetries) {
+        return false;
+    }
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    bool retryable = statusCode == 429 || statusCode == 502 || statusCode == 503 || statusCode == 504;
+    if (statusCode == 0) {
+        // No reply at all - a reply with partial content can't be retried, as it might be parsed already
+        switch (reply->error()) {
+        case QNetworkReply::RemoteHostClosedError:
+        case QNetworkReply::TimeoutError:
+        case QNetworkReply::TemporaryNetworkFailureError:
+        case QNetworkReply::NetworkSessionFailedError:
+        case QNetworkReply::UnknownNetworkError:
+            retryable = true;
+            break;
+        default:
+            break;
+        }
+    }
+    if (!retryable) {
+        return false;
+    }
+
+    const int delay = retryDelay(reply, request.attempt);
+    WRN << "Retrying" << request.url.path() << "in" << delay << "ms. Status:" << statusCode << reply->errorString();
+    if (statusCode == 429) {
+        // The rate limit is per user, so all other requests have to wait as well
+        throttle(delay);
+    }
+
+    QueuedRequest retry = request;
+    ++retry.attempt;
+    startRetryTimer(retry.requestId, delay, [this, retry]() {
+        insertIntoQueue(retry);
+        startQueuedRequests();
+    });
+    return true;
+}
+
+/*!
+ * Calls \a retry after \a delay msecs, unless the request \a requestId is cancelled before.
+ * The client is busy while waiting.
+ */
+void QGitlabClient::startRetryTimer(int requestId, int delay, const std::function<void()> &retry)
+{
+    auto timer = new QTimer(this);
+    timer->setSingleShot(true);
+    m_retryTimers.insert(requestId, timer);
+    connect(timer, &QTimer::timeout, this, [this, timer, requestId, retry]() {
+        m_retryTimers.remove(requestId, timer);
+        timer->deleteLater();
+        retry();
+        updateBusyState();
+    });
+    timer->start(delay);
+    updateBusyState();
+}
+
+/*!
+ * Returns the time to wait before the next retry. That's the Retry-After time of the server if set, otherwise an
+ * exponential backoff with jitter, so parallel requests don't retry all at the same time.
+ */
+int QGitlabClient::retryDelay(QNetworkReply *reply, int attempt) const
+{
+    const QByteArray retryAfter = reply->rawHeader("Retry-After").trimmed();
+    if (!retryAfter.isEmpty()) {
+        bool ok = false;
+        const int seconds = retryAfter.toInt(&ok);
+        if (ok) {
+            return std::clamp(seconds * 1000, 0, kRetryMaxDelayMsecs);
+        }
+        const QDateTime retryTime = QDateTime::fromString(QString::fromLatin1(retryAfter), Qt::RFC2822Date);
+        if (retryTime.isValid()) {
+            const qint64 msecs = QDateTime::currentDateTimeUtc().msecsTo(retryTime);
+            return int(std::clamp<qint64>(msecs, 0, kRetryMaxDelayMsecs));
+        }
+    }
+
+    const int delay = std::min(kRetryBaseDelayMsecs << std::min(attempt, 16), kRetryMaxDelayMsecs);
+    return QRandomGenerator::global()->bounded(delay / 2, delay + 1);
+}
+
+/*!
+ * Reads the RateLimit headers of the \a reply. If only a few requests are left before the limit is reached, the
+ * remaining requests are spread until the limit is reset.
+ */
+void QGitlabClient::updateRateLimit(QNetworkReply *reply)
+{
+    const QByteArray remainingHeader = reply->rawHeader("RateLimit-Remaining");
+    if (remainingHeader.isEmpty()) {
+        return;
+    }
+
+    const int remaining = remainingHeader.toInt();
+    const int limit = reply->rawHeader("RateLimit-Limit").toInt();
+    const qint64 resetMsecs = reply->rawHeader("RateLimit-Reset").toLongLong() * 1000;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (remaining > std::max(kMinRateLimitReserve, limit / 10) || resetMsecs <= now) {
+        m_throttleInterval = 0;
+        return;
+    }
+
+    m_throttleInterval = (resetMsecs - now) / std::max(1, remaining);
+    throttle(m_throttleInterval);
+}
+
+/*!
+ * No request is sent in the next \a msecs
+ */
+void QGitlabClient::throttle(qint64 msecs)
+{
+    m_throttledUntil = std::max(m_throttledUntil, QDateTime::currentMSecsSinceEpoch() + msecs);
+    m_throttleTimer.stop();
+}
+
+/*!
+ * Reads the data of the \a reply that arrived so far, and decompresses it. All reply data has to be read with this
+ * function, so the transfer stats are complete.
+ */
+QByteArray QGitlabClient::readReply(QNetworkReply *reply)
+{
+    const qint64 start = m_metrics.now();
+    ReplyTransfer &transfer = m_replyTransfers[reply];
+    if (!transfer.decoder) {
+        const QByteArray encoding = reply->rawHeader("Content-Encoding");
+        if (!ContentDecoder::isSupported(encoding)) {
+            WRN << "Unsupported content encoding" << encoding;
+        }
+        transfer.decoder = std::make_shared<ContentDecoder>(encoding);
+    }
+
+    const QByteArray data = reply->readAll();
+    const QByteArray decoded = transfer.decoder->decode(data);
+    transfer.timing.wireBytes += data.size();
+    transfer.timing.decodedBytes += decoded.size();
+    transfer.timing.parseUsecs += m_metrics.now() - start;
+    return decoded;
+}
+
+/*!
+ * Starts the timing of the \a reply. The phases of the request are taken from the signals of the reply.
+ */
+void QGitlabClient::traceReply(QNetworkReply *reply, const QueuedRequest &request)
+{
+    RequestTiming &timing = m_replyTransfers[reply].timing;
+    timing.requestId = request.requestId;
+    timing.category = transferCategory(request);
+    timing.method = request.type == QGitlabClient::GET ? "GET" : request.type == QGitlabClient::POST ? "POST" : "PUT";
+    timing.path = request.url.path();
+    timing.attempt = request.attempt;
+    timing.queuedAt = request.queuedAt;
+    timing.startedAt = m_metrics.now();
+
+    auto mark = [this, reply](qint64 RequestTiming::*phase) {
+        auto it = m_replyTransfers.find(reply);
+        if (it != m_replyTransfers.end() && it->timing.*phase < 0) {
+            it->timing.*phase = m_metrics.now();
+        }
+    };
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    connect(reply, &QNetworkReply::socketStartedConnecting, this, [mark]() { mark(&RequestTiming::connectingAt); });
+    connect(reply, &QNetworkReply::requestSent, this, [mark]() { mark(&RequestTiming::sentAt); });
+#endif
+#ifndef QT_NO_SSL
+    connect(reply, &QNetworkReply::encrypted, this, [mark]() { mark(&RequestTiming::encryptedAt); });
+#endif
+    connect(reply, &QNetworkReply::metaDataChanged, this, [mark]() { mark(&RequestTiming::firstByteAt); });
+}
+
+/*!
+ * Adds the bytes received by the finished \a reply to the transfer stats
+ */
+void QGitlabClient::recordTransfer(QNetworkReply *reply, const QueuedRequest &request)
+{
+    ReplyTransfer transfer = m_replyTransfers.take(reply);
+    TransferStats &stats = m_transferStats[transferCategory(request)];
+    ++stats.requests;
+    if (transfer.decoder && transfer.decoder->isCompressed()) {
+        ++stats.compressedReplies;
+    }
+    stats.wireBytes += transfer.timing.wireBytes;
+    stats.decodedBytes += transfer.timing.decodedBytes;
+
+    transfer.timing.statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    m_metrics.addRequest(transfer.timing);
+    Q_EMIT requestFinished(transfer.timing);
+}
+
+QString QGitlabClient::transferCategory(const QueuedRequest &request)
+{
+    const QString path = request.url.path();
+    if (path.endsWith("/graphql")) {
+        return QStringLiteral("graphql");
+    }
+    if (request.type != QGitlabClient::GET) {
+        return QStringLiteral("edits");
+    }
+    if (path.endsWith("/issues")) {
+        return QStringLiteral("issues");
+    }
+    if (path.endsWith("/labels")) {
+        return QStringLiteral("labels");
+    }
+    if (path.endsWith("/groups")) {
+        return QStringLiteral("groups");
+    }
+    return QStringLiteral("projects");
+}
+
+QGitlabClient::TransferStats QGitlabClient::transferStats(const QString &category) const
+{
+    if (!category.isEmpty()) {
+        return m_transferStats.value(category);
+    }
+
+    TransferStats total;
+    for (const TransferStats &stats : m_transferStats) {
+        total.requests += stats.requests;
+        total.compressedReplies += stats.compressedReplies;
+        total.wireBytes += stats.wireBytes;
+        total.decodedBytes += stats.decodedBytes;
+    }
+    return total;
+}
+
+QStringList QGitlabClient::transferCategories() const
+{
+    return m_transferStats.keys();
+}
+
+void QGitlabClient::resetTransferStats()
+{
+    m_transferStats.clear();
 }
 
-QNetworkReply *QGitlabClient::sendRequest(QGitlabClient::ReqType reqType, const QUrl &uri)
+RequestMetrics &QGitlabClient::metrics()
+{
+    return m_metrics;
+}
+
+const RequestMetrics &QGitlabClient::metrics() const
+{
+    return m_metrics;
+}
+
+/*!
+ * Sends the request. If \a jsonBody is set, it is sent as JSON document (for POST requests), otherwise the query of
+ * the \a uri is sent as form data.
+ */
+QNetworkReply *QGitlabClient::sendRequest(QGitlabClient::ReqType reqType, const QUrl &uri, const QByteArray &jsonBody)
 {
     QNetworkRequest request(uri);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, m_http2Enabled);
     request.setRawHeader("PRIVATE-TOKEN", mToken.toUtf8());
-    request.setHeader(QNetworkRequest::ContentTypeHeader, kContentType);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, jsonBody.isEmpty() ? kContentType : kJsonContentType);
+    // Set explicitly, so Qt does not decompress the reply itself and the compressed size can be counted
+    request.setRawHeader("Accept-Encoding", kAcceptEncoding);
+    if (reqType == QGitlabClient::GET) {
+        m_pageCache.addValidators(request);
+    }
 
     QNetworkReply *reply;
     switch (reqType) {
@@ -310,7 +960,7 @@ QNetworkReply *QGitlabClient::sendRequest(QGitlabClient::ReqType reqType, const
         break;
     }
     case QGitlabClient::POST: {
-        reply = mManager.post(request, uri.query(QUrl::FullyEncoded).toUtf8());
+        reply = mManager.post(request, jsonBody.isEmpty() ? uri.query(QUrl::FullyEncoded).toUtf8() : jsonBody);
         break;
     }
     case QGitlabClient::PUT: {
@@ -325,29 +975,448 @@ QNetworkReply *QGitlabClient::sendRequest(QGitlabClient::ReqType reqType, const
     return reply;
 }
 
-bool QGitlabClient::requestNextPage(QNetworkReply *reply, const RequestOptions &options)
+void QGitlabClient::setMaxParallelPages(int pages)
 {
-    int page = pageNumberFromHeader(reply);
-    const int totalPages = totalPagesFromHeader(reply);
-    if (page >= 0 && totalPages >= 0) {
-        if (page < totalPages) {
-            if (isIssueRequest(reply)) {
-                IssueRequestOptions nextPage = dynamic_cast<const IssueRequestOptions &>(options);
-                nextPage.mPage = page + 1;
-                m_busy = false; // workaround to enable request for the next page
-                requestIssues(nextPage);
-            } else {
-                LabelsRequestOptions nextPage = dynamic_cast<const LabelsRequestOptions &>(options);
+    m_maxParallelPages = std::max(1, pages);
+}
+
+int QGitlabClient::maxParallelPages() const
+{
+    return m_maxParallelPages;
+}
+
+void QGitlabClient::setPageDelivery(PageDelivery delivery)
+{
+    m_pageDelivery = delivery;
+}
+
+QGitlabClient::PageDelivery QGitlabClient::pageDelivery() const
+{
+    return m_pageDelivery;
+}
+
+void QGitlabClient::setFetchBackend(FetchBackend backend)
+{
+    m_fetchBackend = backend;
+}
+
+QGitlabClient::FetchBackend QGitlabClient::fetchBackend() const
+{
+    return m_fetchBackend;
+}
+
+/*!
+ * Requests one page of issues. If \a url is not set, the url of the page is composed from the options of the fetch
+ */
+void QGitlabClient::requestIssuesPage(const std::shared_ptr<IssuesFetch> &fetch, int page, const QUrl &url)
+{
+    IssueRequestOptions options = fetch->options;
+    if (page == kProbePage) {
+        options.mPage = 1;
+        options.mPerPage = kAdaptiveFirstPageSize;
+    } else {
+        options.mPage = page;
+        options.mPerPage = fetch->perPage;
+    }
+    ++fetch->pagesInFlight;
+    auto stream = std::make_shared<IssuesPageStream>();
+    stream->timer.start();
+    stream->startedAt = m_metrics.now();
+    enqueueRequest(
+            fetch->requestId, NormalPriority, QGitlabClient::GET,
+            url.isValid() ? url : mUrlComposer.composeGetIssuesUrl(options.mProjectID, options),
+            [fetch, stream, page, this](QNetworkReply *reply) { handleIssuesPage(reply, fetch, stream, page); },
+            [fetch, stream, this](QNetworkReply *reply) {
+                if (!fetch->failed) {
+                    readIssuesStream(reply, stream);
+                }
+            });
+}
+
+/*!
+ * Parses the issues of the data that arrived so far in the thread pool. The raw page is never kept as a whole in
+ * memory
+ */
+void QGitlabClient::readIssuesStream(QNetworkReply *reply, const std::shared_ptr<IssuesPageStream> &stream)
+{
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+        return;
+    }
+
+    const QByteArray data = readReply(reply);
+    if (data.isEmpty()) {
+        return;
+    }
+    stream->bytes += data.size();
+
+    auto parse = [stream, data]() {
+        if (stream->parser.hasError()) {
+            return;
+        }
+        const qint64 start = stream->timer.nsecsElapsed() / 1000;
+        const QList<QJsonObject> objects = stream->parser.addData(data);
+        stream->issues.reserve(stream->issues.size() + objects.size());
+        for (const QJsonObject &object : objects) {
+            stream->issues.push_back(Issue(object));
+        }
+        stream->parsedAt = stream->timer.nsecsElapsed() / 1000;
+        stream->parseUsecs += stream->parsedAt - start;
+    };
+    // Chunks of one page are parsed in order, pages are parsed in parallel
+    stream->parsing = stream->parsing.isValid() ? stream->parsing.then(QThreadPool::globalInstance(), parse)
+                                                : QtConcurrent::run(QThreadPool::globalInstance(), parse);
+}
+
+void QGitlabClient::handleIssuesPage(QNetworkReply *reply, const std::shared_ptr<IssuesFetch> &fetch,
+        const std::shared_ptr<IssuesPageStream> &stream, int page)
+{
+    --fetch->pagesInFlight;
+
+    if (!fetch->failed) {
+        const PageCache::Entry *cached = PageCache::isNotModified(reply) ? m_pageCache.entry(reply) : nullptr;
+        if (cached) {
+            const QList<Issue> issues = cached->issues;
+            continueIssuesFetch(pageHeaders(reply), fetch, page, issues);
+        } else if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
+            readIssuesStream(reply, stream);
+            const PageHeaders headers = pageHeaders(reply);
+            const QUrl url = reply->request().url();
+            const PageCache::Entry cacheEntry = PageCache::entryOf(reply);
+            const qint64 downloadMsecs = stream->timer.elapsed();
+            const int requestId = fetch->requestId;
+            ++m_parsingPages[requestId];
+
+            auto parsed = [this, fetch, stream, page, headers, url, cacheEntry, downloadMsecs, requestId]() {
+                if (!takeParsedPage(requestId)) {
+                    return; // cancelled
+                }
+                const qint64 parsedAt = stream->startedAt + stream->parsedAt;
+                m_metrics.addSpan("parse page", requestId, parsedAt - stream->parseUsecs, parsedAt);
+                if (fetch->failed) {
+                    return;
+                }
+                if (stream->parser.hasError() || !stream->parser.atEnd()) {
+                    const QString &errMsg = QString("ERROR: QGitlabClient::requestIssues: Parsing json data: %1")
+                                                    .arg(stream->parser.hasError() ? stream->parser.errorString()
+                                                                                   : QString("unexpected end of data"));
+                    WRN << errMsg;
+                    fetch->failed = true;
+                    notifyError(nullptr, errMsg);
+                    return;
+                }
+
+                const QList<Issue> issues = std::move(stream->issues);
+                if (page == kProbePage) {
+                    fetch->probeBytes = stream->bytes;
+                    fetch->probeMsecs = downloadMsecs;
+                }
+                PageCache::Entry entry = cacheEntry;
+                entry.issues = issues;
+                m_pageCache.insert(url, entry);
+                continueIssuesFetch(headers, fetch, page, issues);
+                finishIssuesFetch(fetch);
+            };
+            if (!stream->parsing.isValid()) {
+                // No data at all - still reported in order with the other pages
+                stream->parsing = QtConcurrent::run(QThreadPool::globalInstance(), []() {});
+            }
+            stream->parsing.then(this, parsed);
+        } else {
+            WRN << reply->error() << reply->errorString();
+            fetch->failed = true;
+            notifyError(reply, "QGitlabClient::requestIssues");
+        }
+    }
+
+    finishIssuesFetch(fetch);
+}
+
+/*!
+ * Emits issueFetchingDone, if all pages of the \a fetch were downloaded and parsed
+ */
+void QGitlabClient::finishIssuesFetch(const std::shared_ptr<IssuesFetch> &fetch)
+{
+    if (fetch->pagesInFlight == 0 && !fetch->failed && !m_parsingPages.contains(fetch->requestId)) {
+        Q_EMIT issueFetchingDone();
+    }
+}
+
+/*!
+ * A page of the request \a requestId was parsed. Returns false, if the request was cancelled meanwhile, so the
+ * page is dropped
+ */
+bool QGitlabClient::takeParsedPage(int requestId)
+{
+    auto it = m_parsingPages.find(requestId);
+    if (it == m_parsingPages.end()) {
+        return false;
+    }
+    if (--(*it) == 0) {
+        m_parsingPages.erase(it);
+    }
+    updateBusyState();
+    return true;
+}
+
+/*!
+ * Reads the pagination headers of the \a reply. For a "304 Not Modified" reply, the headers are taken from the cache
+ */
+QGitlabClient::PageHeaders QGitlabClient::pageHeaders(QNetworkReply *reply) const
+{
+    PageHeaders headers;
+    headers.totalPages = totalPagesFromHeader(reply);
+    headers.nextPage = numberHeaderAttribute(reply, "x-next-page");
+    headers.nextLink = nextPageLink(reply);
+    headers.totalItems = numberHeaderAttribute(reply, "x-total");
+    return headers;
+}
+
+void QGitlabClient::requestGraphQLIssuesPage(const std::shared_ptr<IssuesFetch> &fetch, int page, const QString &cursor)
+{
+    const QJsonObject query = fetch->options.graphQLQuery(m_projectPaths.value(fetch->options.mProjectID), cursor);
+    ++fetch->pagesInFlight;
+    enqueueRequest(
+            fetch->requestId, NormalPriority, QGitlabClient::POST, mUrlComposer.composeGraphQLUrl(),
+            [fetch, page, this](QNetworkReply *reply) { handleGraphQLIssuesPage(reply, fetch, page); }, {},
+            QJsonDocument(query).toJson(QJsonDocument::Compact));
+}
+
+/*!
+ * Handles one page of issues of the GraphQL API. The page is parsed in the thread pool. The pages are linked by
+ * cursors, so the next page is requested only after the current one was parsed
+ */
+void QGitlabClient::handleGraphQLIssuesPage(QNetworkReply *reply, const std::shared_ptr<IssuesFetch> &fetch, int page)
+{
+    --fetch->pagesInFlight;
+
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+        WRN << reply->error() << reply->errorString();
+        notifyError(reply, "QGitlabClient::requestIssues");
+        return;
+    }
+
+    const QByteArray data = readReply(reply);
+    const int requestId = fetch->requestId;
+    const qint64 scheduledAt = m_metrics.now();
+    QElapsedTimer timer;
+    timer.start();
+    ++m_parsingPages[requestId];
+
+    QtConcurrent::run(QThreadPool::globalInstance(), [data, timer]() {
+        GraphQLPage result;
+        result.parseStart = timer.nsecsElapsed() / 1000;
+        QJsonParseError jsonError;
+        const QJsonDocument replyContent = QJsonDocument::fromJson(data, &jsonError);
+        if (QJsonParseError::NoError != jsonError.error) {
+            result.errorString = QString("ERROR: QGitlabClient::requestIssues: Parsing json data: %1, #%2")
+                                         .arg(jsonError.errorString())
+                                         .arg(jsonError.offset);
+            result.parseEnd = timer.nsecsElapsed() / 1000;
+            return result;
+        }
+
+        const QJsonObject content = replyContent.object();
+        const QJsonArray errors = content["errors"].toArray();
+        const QJsonObject issuesObject = content["data"]["project"]["issues"].toObject();
+        if (!errors.isEmpty() || issuesObject.isEmpty()) {
+            const QString errMsg = errors.isEmpty() ? QString("Project not found")
+                                                    : errors.first()["message"].toString();
+            result.errorString = QString("ERROR: QGitlabClient::requestIssues: %1").arg(errMsg);
+            result.parseEnd = timer.nsecsElapsed() / 1000;
+            return result;
+        }
+
+        const QJsonArray nodes = issuesObject["nodes"].toArray();
+        result.issues.reserve(nodes.size());
+        for (const QJsonValue &node : nodes) {
+            result.issues.push_back(Issue::fromGraphQL(node.toObject()));
+        }
+        const QJsonObject pageInfo = issuesObject["pageInfo"].toObject();
+        result.hasNextPage = pageInfo["hasNextPage"].toBool();
+        result.endCursor = pageInfo["endCursor"].toString();
+        result.parseEnd = timer.nsecsElapsed() / 1000;
+        return result;
+    }).then(this, [this, fetch, page, requestId, scheduledAt](const GraphQLPage &result) {
+        if (!takeParsedPage(requestId)) {
+            return; // cancelled
+        }
+        m_metrics.addSpan("parse page", requestId, scheduledAt + result.parseStart, scheduledAt + result.parseEnd);
+        if (!result.errorString.isEmpty()) {
+            WRN << result.errorString;
+            notifyError(nullptr, result.errorString);
+            return;
+        }
+
+        if (result.hasNextPage) {
+            requestGraphQLIssuesPage(fetch, page + 1, result.endCursor);
+        }
+        deliverIssuesPage(fetch, page, result.issues);
+        finishIssuesFetch(fetch);
+    });
+}
+
+/*!
+ * Delivers the \a issues of the \a page and requests the following pages
+ */
+void QGitlabClient::continueIssuesFetch(
+        const PageHeaders &headers, const std::shared_ptr<IssuesFetch> &fetch, int page, const QList<Issue> &issues)
+{
+    if (page == kProbePage) {
+        startAdaptiveIssuesFetch(headers, fetch, issues);
+        return;
+    }
+
+    if (fetch->totalPages < 0 && !fetch->options.mKeysetPagination) {
+        fetch->totalPages = headers.totalPages;
+    }
+    if (fetch->totalPages < 0) {
+        // Without the number of pages, only the next one is known
+        if (headers.nextPage > page && !fetch->options.mKeysetPagination) {
+            requestIssuesPage(fetch, headers.nextPage);
+        } else if (headers.nextLink.isValid()) {
+            requestIssuesPage(fetch, page + 1, headers.nextLink);
+        }
+    }
+    if (page == 1 && fetch->skipIssues > 0) {
+        deliverIssuesPage(fetch, page, issues.mid(fetch->skipIssues));
+    } else {
+        deliverIssuesPage(fetch, page, issues);
+    }
+    requestMoreIssuesPages(fetch);
+}
+
+/*!
+ * The small first page of an adaptive fetch arrived. The rest of the issues is requested with the page size
+ * picked by adaptivePageSize(). Page 1 of that size overlaps the first page, its first issues are skipped.
+ */
+void QGitlabClient::startAdaptiveIssuesFetch(
+        const PageHeaders &headers, const std::shared_ptr<IssuesFetch> &fetch, const QList<Issue> &issues)
+{
+    deliverIssuesPage(fetch, kProbePage, issues);
+    if (issues.size() < kAdaptiveFirstPageSize) {
+        // All issues fit on the first page
+        fetch->totalPages = 0;
+        return;
+    }
+
+    fetch->perPage = adaptivePageSize(*fetch, issues.size());
+    fetch->skipIssues = issues.size();
+    const int totalIssues = headers.totalItems;
+    if (totalIssues >= 0) {
+        fetch->totalPages = (totalIssues + fetch->perPage - 1) / fetch->perPage;
+        fetch->nextPageToRequest = 1;
+        requestMoreIssuesPages(fetch);
+    } else {
+        // Without the number of issues, the pages are followed one by one
+        fetch->totalPages = -1;
+        requestIssuesPage(fetch, 1);
+    }
+}
+
+/*!
+ * Big pages need less round trips. But if the issues are big and the server answers quickly, smaller pages let
+ * more requests share the download in parallel.
+ */
+int QGitlabClient::adaptivePageSize(const IssuesFetch &fetch, int issueCount) const
+{
+    const int maxPageSize = std::max(kAdaptiveFirstPageSize, std::min(fetch.options.mPerPage, kMaxPerPage));
+    if (issueCount <= 0 || fetch.probeBytes <= 0 || fetch.probeMsecs >= kSlowPageMsecs) {
+        return maxPageSize;
+    }
+
+    const qint64 bytesPerIssue = std::max<qint64>(1, fetch.probeBytes / issueCount);
+    const qint64 pageSize = kMaxAdaptivePageBytes / bytesPerIssue;
+    return int(std::clamp<qint64>(pageSize, kAdaptiveFirstPageSize, maxPageSize));
+}
+
+/*!
+ * Requests the pages that are known to exist, but were not requested yet.
+ * Not more than maxParallelPages() are requested at the same time.
+ */
+void QGitlabClient::requestMoreIssuesPages(const std::shared_ptr<IssuesFetch> &fetch)
+{
+    while (fetch->pagesInFlight < m_maxParallelPages && fetch->nextPageToRequest <= fetch->totalPages) {
+        requestIssuesPage(fetch, fetch->nextPageToRequest);
+        ++fetch->nextPageToRequest;
+    }
+}
+
+void QGitlabClient::deliverIssuesPage(const std::shared_ptr<IssuesFetch> &fetch, int page, const QList<Issue> &issues)
+{
+    if (m_pageDelivery == ArrivalOrder) {
+        Q_EMIT pageOfIssues(page, issues);
+        Q_EMIT listOfIssues(issues);
+        return;
+    }
+
+    fetch->finishedPages.insert(page, issues);
+    while (fetch->finishedPages.contains(fetch->nextPageToDeliver)) {
+        const QList<Issue> pageIssues = fetch->finishedPages.take(fetch->nextPageToDeliver);
+        Q_EMIT pageOfIssues(fetch->nextPageToDeliver, pageIssues);
+        Q_EMIT listOfIssues(pageIssues);
+        ++fetch->nextPageToDeliver;
+    }
+}
+
+bool QGitlabClient::requestNextPage(int requestId, QNetworkReply *reply, const LabelsRequestOptions &options)
+{
+    if (!options.mKeysetPagination) {
+        int page = pageNumberFromHeader(reply);
+        const int totalPages = totalPagesFromHeader(reply);
+        if (page >= 0 && totalPages >= 0) {
+            if (page < totalPages) {
+                LabelsRequestOptions nextPage = options;
                 nextPage.mPage = page + 1;
-                m_busy = false; // workaround to enable request for the next page
-                requestListofLabels(nextPage);
+                requestLabelsPage(requestId, nextPage);
+                return true;
             }
+            return false;
+        }
+
+        // Large result sets have no x-total-pages header
+        const int nextPageNumber = numberHeaderAttribute(reply, "x-next-page");
+        if (nextPageNumber > page) {
+            LabelsRequestOptions nextPage = options;
+            nextPage.mPage = nextPageNumber;
+            requestLabelsPage(requestId, nextPage);
             return true;
         }
     }
+
+    const QUrl nextLink = nextPageLink(reply);
+    if (nextLink.isValid()) {
+        requestLabelsPage(requestId, options, nextLink);
+        return true;
+    }
     return false;
 }
 
+QUrl QGitlabClient::nextPageLink(QNetworkReply *reply) const
+{
+    if (!reply) {
+        return {};
+    }
+
+    QByteArray linkHeader = reply->rawHeader("Link");
+    if (linkHeader.isEmpty() && PageCache::isNotModified(reply)) {
+        linkHeader = m_pageCache.rawHeader(reply, "Link");
+    }
+
+    // Format: <https://host/api/v4/...>; rel="next", <https://host/api/v4/...>; rel="first"
+    for (const QByteArray &link : linkHeader.split(',')) {
+        const qsizetype urlStart = link.indexOf('<');
+        const qsizetype urlEnd = link.indexOf('>', urlStart);
+        if (urlStart < 0 || urlEnd < 0) {
+            continue;
+        }
+        const QByteArray params = link.mid(urlEnd + 1);
+        if (params.contains("rel=\"next\"") || params.contains("rel=next")) {
+            return QUrl::fromEncoded(link.mid(urlStart + 1, urlEnd - urlStart - 1));
+        }
+    }
+    return {};
+}
+
 int QGitlabClient::pageNumberFromHeader(QNetworkReply *reply) const
 {
     return numberHeaderAttribute(reply, "x-page");
@@ -364,7 +1433,10 @@ int QGitlabClient::numberHeaderAttribute(QNetworkReply *reply, const QString &he
         return -1;
     }
 
-    const QString pageAttribute = reply->rawHeader(headername.toUtf8());
+    QString pageAttribute = reply->rawHeader(headername.toUtf8());
+    if (pageAttribute.isEmpty() && PageCache::isNotModified(reply)) {
+        pageAttribute = m_pageCache.rawHeader(reply, headername.toUtf8());
+    }
     if (pageAttribute.isEmpty()) {
         return -1;
     }
@@ -383,11 +1455,6 @@ void QGitlabClient::setBusy(bool busy)
 }
 }
 
-bool gitlab::QGitlabClient::isIssueRequest(QNetworkReply *reply) const
-{
-    return reply->request().url().query().contains("api/v4/issues");
-}
-
 void gitlab::QGitlabClient::notifyError(QNetworkReply *reply, const QString &text)
 {
     const QStringList fields {
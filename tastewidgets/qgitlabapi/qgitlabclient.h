@@ -3,20 +3,35 @@
 #include "QGitlabAPI_global.h"
 #include "issue.h"
 #include "label.h"
+#include "pagecache.h"
+#include "projectidcache.h"
+#include "requestmetrics.h"
 #include "urlcomposer.h"
 
+#include <QHash>
 #include <QList>
+#include <QMap>
 #include <QNetworkAccessManager>
 #include <QString>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
 
 namespace gitlab {
 
+class ContentDecoder;
 class IssueRequestOptions;
 class LabelsRequestOptions;
 class RequestOptions;
 
 /**
  * @brief The QGitlabClient class is the main class to start requests on the Gitlab server
+ *
+ * All requests are queued and sent by priority. Up to maxConcurrentRequests() requests are running at the
+ * same time. Each public request function returns an ID, that can be used to cancel the request (including
+ * all pages that belong to it) with cancelRequest().
+ * Pages of issues are parsed in the global thread pool. The signals are still emitted in the thread of the client.
  */
 class QGITLABAPI_EXPORT QGitlabClient : public QObject
 {
@@ -31,76 +46,207 @@ public:
         PUT = 2,
     };
 
+    /*!
+     * Order in which the pages of a parallel issue fetch are emitted
+     */
+    enum PageDelivery
+    {
+        InPageOrder = 0, /// pages are emitted in ascending page number
+        ArrivalOrder = 1, /// pages are emitted as soon as they arrived
+    };
+
+    /*!
+     * Priority of a queued request. Requests with a higher priority are sent first.
+     */
+    enum Priority
+    {
+        LowPriority = 0, /// background refreshes, like the list of labels
+        NormalPriority = 1, /// fetching issues and project data
+        HighPriority = 2, /// user actions, like creating, editing or closing issues
+    };
+
+    /*!
+     * API that is used to fetch lists of issues
+     */
+    enum FetchBackend
+    {
+        RestBackend = 0, /// REST API, pages are fetched in parallel
+        GraphQLBackend = 1, /// GraphQL API, only the fields used by Issue are fetched. Pages are fetched one by one
+    };
+
+    /*!
+     * Bytes received for one kind of request, \see transferStats
+     */
+    struct TransferStats {
+        int requests = 0; /// finished requests
+        int compressedReplies = 0; /// replies that were sent gzip or deflate encoded
+        qint64 wireBytes = 0; /// body bytes as received from the server
+        qint64 decodedBytes = 0; /// body bytes after decompression
+    };
+
     QGitlabClient();
     /*!
      * \brief Sets the url and token to operate with the GitlabAPI
      * \param The url parameter is stripped of the project name and set with the path "/api/v4" so it can
      *        be used with the different Gitlab API Endpoints
      * \param This the personal token used on any call to the Gitlab API.
+     * The connection to the server is opened right away, so the TLS handshake is done, when the first request is
+     * sent.
      */
     void setCredentials(const QString &url, const QString &token);
+    /*!
+     * \brief Allows HTTP/2 for all requests (enabled by default).
+     * With HTTP/2 the parallel page and label requests share one TLS connection to the server.
+     */
+    void setHttp2Enabled(bool enabled);
+    bool http2Enabled() const;
     /*!
      * \brief Makes one or more request to the gitlab api to retrieve all the requirements
      * \param the options are used to filter the requirements search
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns the ID of the queued request
      */
-    bool requestIssues(const IssueRequestOptions &options);
+    int requestIssues(const IssueRequestOptions &options);
     /*!
      * \brief Edits any Issue (requirement or review)
      * \param projectID used for the query
      * \param issueID used for the query
      * \param newIssue the issue with the edits that need to be changed.
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns the ID of the queued request
      */
-    bool editIssue(const int &projectID, const int &issueID, const Issue &newIssue);
+    int editIssue(const int &projectID, const int &issueID, const Issue &newIssue);
     /*!
      * \brief Creates a new issue (requirement or review)
      * \param projectID used for the query
      * \param title that corresponds to the gitlab issue title
      * \param description that corresponds to the gitlab issue description
      * \param labels that will be included in the issue
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns the ID of the queued request
      */
-    bool createIssue(const int &projectID, const QString &title, const QString &description, const QStringList &labels);
+    int createIssue(const int &projectID, const QString &title, const QString &description, const QStringList &labels);
     /*!
      * \brief Closes an issue (removes a requirement or review)
      * \param projectID used for the query
      * \param issueID used for the query
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns the ID of the queued request
      */
-    bool closeIssue(const int &projectID, const int &issueID);
+    int closeIssue(const int &projectID, const int &issueID);
+    /*!
+     * \brief Edits a list of issues. The edits are sent a few at a time, failing edits are retried.
+     * The result of each edit is reported by batchItemFinished, the end of the batch by batchFinished.
+     * \param projectID used for the query
+     * \param issues the issues with the edits. The issue ID is taken from Issue::mIssueIID
+     * \return Returns the ID of the batch. It can be used to cancel the remaining edits
+     */
+    int editIssues(const int &projectID, const QList<Issue> &issues);
+    /*!
+     * \brief Closes a list of issues. \see editIssues
+     */
+    int closeIssues(const int &projectID, const QList<int> &issueIDs);
+    /*!
+     * \brief Adds and removes labels of a list of issues. All other labels of the issues are kept. \see editIssues
+     */
+    int relabelIssues(const int &projectID, const QList<int> &issueIDs, const QStringList &addLabels,
+            const QStringList &removeLabels);
     /*!
      * \brief Makes one or more request to the gitlab api to retrieve all the labels
      * \param the options are used to filter the labels search
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns the ID of the queued request
      */
 
-    bool requestListofLabels(const LabelsRequestOptions &options);
+    int requestListofLabels(const LabelsRequestOptions &options);
     /*!
      * \brief request the project ID to be used on any of the queries to the gitlab API
-     * \param projectID retrieveed using the project name included in the url
-     * \return Returns true if there's a pending request otherwise false.
+     * The project is looked up by its path. The IDs are cached across sessions: a known ID is reported right away
+     * and is revalidated with the server. requestedProjectID is emitted again only if the ID changed.
+     * \param projectUrl the url of the project, like "https://gitlab.com/group/project"
+     * \return Returns the ID of the queued request
      */
 
-    bool requestProjectId(const QUrl &projectUrl);
+    int requestProjectId(const QUrl &projectUrl);
     /*!
-     * \brief Helper function that returns true if there is any ongoing request to the gitlab server
+     * \brief Helper function that returns true if there is any queued or ongoing request to the gitlab server
      * \return true if busy
      */
     bool isBusy() const;
 
-    bool requestGroupID(const QString &groupName);
+    /*!
+     * \brief Cancels a queued or running request, including all pages that belong to it.
+     * The results of a cancelled request are dropped.
+     * \param requestId The ID returned when the request was made
+     * \return true if there was anything to cancel
+     */
+    bool cancelRequest(int requestId);
+    bool isRequestPending(int requestId) const;
+    /*!
+     * \brief Sets the number of requests that are sent to the server at the same time
+     */
+    void setMaxConcurrentRequests(int requests);
+    int maxConcurrentRequests() const;
 
-    bool createProject(const QString &projectName, const QString &groupID);
+    /*!
+     * \brief Sets how often a GET request is retried, if it failed for a temporary reason.
+     * Rate limited (429), overloaded (502, 503, 504) and lost connections are retried with an exponential backoff
+     * and jitter. A Retry-After header of the server is respected.
+     */
+    void setMaxRetries(int retries);
+    int maxRetries() const;
+
+    /*!
+     * \brief Sets the number of issue pages that are requested at the same time.
+     * Once the first page reports the total number of pages (`x-total-pages`), the remaining pages are
+     * requested in a window of at most \p pages requests. A value of 1 fetches one page after the other.
+     */
+    void setMaxParallelPages(int pages);
+    int maxParallelPages() const;
+    /*!
+     * \brief Sets if pages of issues are emitted in page order, or as soon as they arrive
+     */
+    void setPageDelivery(PageDelivery delivery);
+    PageDelivery pageDelivery() const;
+    /*!
+     * \brief Sets the API used by requestIssues.
+     * The GraphQL API needs the path of the project, so it is used only for projects that were resolved by
+     * requestProjectId. For all other projects the REST API is used.
+     */
+    void setFetchBackend(FetchBackend backend);
+    FetchBackend fetchBackend() const;
+
+    /*!
+     * \brief Returns the bytes received for one kind of request since the last resetTransferStats().
+     * All requests ask for gzip compressed replies, so \a wireBytes is usually much smaller than \a decodedBytes.
+     * \param category one of "issues", "labels", "graphql", "projects", "groups" or "edits". An empty category
+     *        returns the sum of all requests
+     */
+    TransferStats transferStats(const QString &category = QString()) const;
+    /*!
+     * \brief Returns the categories there are transfer stats for
+     */
+    QStringList transferCategories() const;
+    void resetTransferStats();
+    /*!
+     * \brief Returns the timing of the latest requests. Users of the client can add the time they spent on the
+     * results (\see RequestMetrics::addSpan), so it shows up in the exported trace as well.
+     */
+    RequestMetrics &metrics();
+    const RequestMetrics &metrics() const;
+
+    int requestGroupID(const QString &groupName);
+
+    int createProject(const QString &projectName, const QString &groupID);
 
 Q_SIGNALS:
     /*!
      * Provides a block/page of issues
      */
     void listOfIssues(QList<Issue>);
+    /*!
+     * Provides a block/page of issues together with the page number it belongs to.
+     * Emitted right before listOfIssues. For fetches with an adaptive page size, the small first page is page 0
+     */
+    void pageOfIssues(int page, QList<Issue>);
     /*!
      * Is send either when fetching data is started. Or when the fething of data ended.
-     * The busy property is true, while the fetching is active
+     * The busy property is true, while any request is queued or running
      */
     void busyStateChanged(bool);
     /*!
@@ -150,28 +296,134 @@ Q_SIGNALS:
      * \param projectName
      */
     void projectCreated(const QString &projectName);
+    /*!
+     * \brief Reports the result of one edit of a batch started by editIssues, closeIssues or relabelIssues
+     * \param batchId the ID returned when the batch was started
+     * \param issueID the issue that was edited
+     * \param success false, if the edit failed (after all retries)
+     */
+    void batchItemFinished(int batchId, int issueID, bool success);
+    /*!
+     * \brief Sent when all edits of a batch are done
+     * \param failedIssueIDs the issues that could not be edited
+     */
+    void batchFinished(int batchId, QList<int> failedIssueIDs);
+    /*!
+     * \brief Sent for each finished request (each page and each retry) with its timing. Cancelled requests are not
+     * reported.
+     */
+    void requestFinished(const gitlab::RequestTiming &timing);
 
 protected:
-    QNetworkReply *sendRequest(ReqType reqType, const QUrl &url);
+    QNetworkReply *sendRequest(ReqType reqType, const QUrl &url, const QByteArray &jsonBody = QByteArray());
     /*!
-     * \brief requestNextPage makes a request for next page (if any ) for issues or labels
+     * \brief requestNextPage queues the request for next page (if any) of labels
+     * The next page is taken from the x-page/x-total-pages headers, the x-next-page header, or the "next" link
+     * of the Link header (keyset pagination) - whichever the server provided.
+     * \param requestId the ID of the request the next page belongs to
      * \param reply
-     * \param options which can be any derived class from RequestOptions
+     * \param options the options of the current page
      * \return true if there was another requestable page
      */
-    bool requestNextPage(QNetworkReply *reply, const RequestOptions &options);
+    bool requestNextPage(int requestId, QNetworkReply *reply, const LabelsRequestOptions &options);
+    /*!
+     * \brief nextPageLink returns the url of the "next" link of the Link header, or an invalid url if there is none
+     */
+    QUrl nextPageLink(QNetworkReply *reply) const;
     int pageNumberFromHeader(QNetworkReply *reply) const;
     int totalPagesFromHeader(QNetworkReply *reply) const;
     int numberHeaderAttribute(QNetworkReply *reply, const QString &headername) const;
     void setBusy(bool busy);
-    bool isIssueRequest(QNetworkReply *reply) const;
+    void warmUpConnection();
 
 private:
+    struct IssuesFetch;
+    struct IssuesPageStream;
+    struct PageHeaders;
+    struct GraphQLPage;
+    struct IssuesBatch;
+    struct ReplyTransfer {
+        std::shared_ptr<ContentDecoder> decoder;
+        RequestTiming timing;
+    };
+    struct QueuedRequest {
+        int requestId;
+        Priority priority;
+        ReqType type;
+        QUrl url;
+        std::function<void(QNetworkReply *)> onFinished;
+        std::function<void(QNetworkReply *)> onReadyRead;
+        QByteArray body;
+        int attempt = 0; /// number of retries so far
+        qint64 queuedAt = -1; /// \see RequestMetrics::now
+    };
+
+    int createRequestId();
+    void enqueueRequest(int requestId, Priority priority, ReqType type, const QUrl &url,
+            const std::function<void(QNetworkReply *)> &onFinished,
+            const std::function<void(QNetworkReply *)> &onReadyRead = {}, const QByteArray &jsonBody = QByteArray());
+    void insertIntoQueue(QueuedRequest request);
+    void startQueuedRequests();
+    void updateBusyState();
+    bool retryRequest(QNetworkReply *reply, const QueuedRequest &request);
+    int retryDelay(QNetworkReply *reply, int attempt) const;
+    void startRetryTimer(int requestId, int delay, const std::function<void()> &retry);
+    void updateRateLimit(QNetworkReply *reply);
+    void throttle(qint64 msecs);
+    QByteArray readReply(QNetworkReply *reply);
+    void traceReply(QNetworkReply *reply, const QueuedRequest &request);
+    void recordTransfer(QNetworkReply *reply, const QueuedRequest &request);
+    static QString transferCategory(const QueuedRequest &request);
+
+    void requestLabelsPage(int requestId, const LabelsRequestOptions &options, const QUrl &url = QUrl());
+    void requestIssuesPage(const std::shared_ptr<IssuesFetch> &fetch, int page, const QUrl &url = QUrl());
+    void readIssuesStream(QNetworkReply *reply, const std::shared_ptr<IssuesPageStream> &stream);
+    void handleIssuesPage(QNetworkReply *reply, const std::shared_ptr<IssuesFetch> &fetch,
+            const std::shared_ptr<IssuesPageStream> &stream, int page);
+    void finishIssuesFetch(const std::shared_ptr<IssuesFetch> &fetch);
+    bool takeParsedPage(int requestId);
+    PageHeaders pageHeaders(QNetworkReply *reply) const;
+    void continueIssuesFetch(const PageHeaders &headers, const std::shared_ptr<IssuesFetch> &fetch, int page,
+            const QList<Issue> &issues);
+    void requestMoreIssuesPages(const std::shared_ptr<IssuesFetch> &fetch);
+    void requestGraphQLIssuesPage(const std::shared_ptr<IssuesFetch> &fetch, int page, const QString &cursor);
+    void handleGraphQLIssuesPage(QNetworkReply *reply, const std::shared_ptr<IssuesFetch> &fetch, int page);
+    void startAdaptiveIssuesFetch(
+            const PageHeaders &headers, const std::shared_ptr<IssuesFetch> &fetch, const QList<Issue> &issues);
+    int adaptivePageSize(const IssuesFetch &fetch, int issueCount) const;
+    int startBatch(const QList<QPair<int, QUrl>> &edits);
+    void sendBatchItems(const std::shared_ptr<IssuesBatch> &batch);
+    void handleBatchItem(QNetworkReply *reply, const std::shared_ptr<IssuesBatch> &batch, int issueID,
+            const QUrl &url, int attempt);
+    void deliverIssuesPage(const std::shared_ptr<IssuesFetch> &fetch, int page, const QList<Issue> &issues);
+
     QString mUsername;
     UrlComposer mUrlComposer;
     QString mToken;
     QNetworkAccessManager mManager;
     bool m_busy = false;
+    int m_maxParallelPages = 6;
+    PageDelivery m_pageDelivery = InPageOrder;
+    FetchBackend m_fetchBackend = RestBackend;
+    QHash<int, QString> m_projectPaths; /// full path of the projects resolved by requestProjectId
+    PageCache m_pageCache;
+    ProjectIdCache mProjectIdCache;
+
+    QList<QueuedRequest> m_queue; /// sorted by priority, first in first out within the same priority
+    QHash<QNetworkReply *, int> m_runningRequests; /// running replies and the request ID they belong to
+    QHash<int, std::shared_ptr<IssuesBatch>> m_batches; /// running batches by their ID
+    int m_maxConcurrentRequests = 6;
+    int m_maxRetries = 4;
+    bool m_http2Enabled = true;
+    QMultiHash<int, QTimer *> m_retryTimers; /// requests waiting to be retried, by request ID
+    QHash<int, int> m_parsingPages; /// number of pages that are parsed in the thread pool, by request ID
+    qint64 m_throttledUntil = 0; /// no request is sent before that time (msecs since epoch)
+    qint64 m_throttleInterval = 0; /// minimum time between two requests, if the rate limit is almost used up
+    QTimer m_throttleTimer;
+    int m_lastRequestId = 0;
+    QHash<QNetworkReply *, ReplyTransfer> m_replyTransfers; /// body bytes and timing of the running replies
+    QMap<QString, TransferStats> m_transferStats; /// by category
+    RequestMetrics m_metrics;
 
     void notifyError(QNetworkReply *reply, const QString &text = QString());
 };
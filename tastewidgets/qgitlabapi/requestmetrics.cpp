@@ -0,0 +1,151 @@
+#include "requestmetrics.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <algorithm>
+
+using namespace gitlab;
+
+static const int kTracePid = 1;
+static const int kTraceTid = 1;
+
+RequestMetrics::RequestMetrics()
+{
+    mClock.start();
+}
+
+qint64 RequestMetrics::now() const
+{
+    return mClock.nsecsElapsed() / 1000;
+}
+
+void RequestMetrics::addRequest(const RequestTiming &timing)
+{
+    mRequests.append(timing);
+    if (mRequests.size() > mMaxEntries) {
+        mRequests.remove(0, mRequests.size() - mMaxEntries);
+    }
+}
+
+void RequestMetrics::addSpan(const QString &name, int requestId, qint64 start, qint64 end)
+{
+    mSpans.append({ name, requestId, start, end });
+    if (mSpans.size() > mMaxEntries) {
+        mSpans.remove(0, mSpans.size() - mMaxEntries);
+    }
+}
+
+QList<RequestTiming> RequestMetrics::requests() const
+{
+    return mRequests;
+}
+
+QList<RequestTiming> RequestMetrics::requests(int requestId) const
+{
+    QList<RequestTiming> result;
+    for (const RequestTiming &timing : mRequests) {
+        if (timing.requestId == requestId) {
+            result.append(timing);
+        }
+    }
+    return result;
+}
+
+QList<RequestMetrics::Span> RequestMetrics::spans() const
+{
+    return mSpans;
+}
+
+void RequestMetrics::clear()
+{
+    mRequests.clear();
+    mSpans.clear();
+}
+
+void RequestMetrics::setMaxEntries(int entries)
+{
+    mMaxEntries = std::max(1, entries);
+}
+
+int RequestMetrics::maxEntries() const
+{
+    return mMaxEntries;
+}
+
+static QJsonObject traceEvent(const QString &phase, const QString &name, const QString &category, qint64 ts)
+{
+    return QJsonObject { { "ph", phase }, { "name", name }, { "cat", category }, { "ts", ts }, { "pid", kTracePid },
+        { "tid", kTraceTid } };
+}
+
+/*!
+ * Each request is an async event, with its phases (queued, connect, waiting for the first byte, download) nested.
+ * The spans are complete events of the main thread.
+ */
+QJsonDocument RequestMetrics::toChromeTrace() const
+{
+    QJsonArray events;
+    for (qsizetype i = 0; i < mRequests.size(); ++i) {
+        const RequestTiming &timing = mRequests.at(i);
+        const qint64 begin = timing.queuedAt >= 0 ? timing.queuedAt : timing.startedAt;
+        if (begin < 0 || timing.finishedAt < begin) {
+            continue;
+        }
+
+        const QString id = QString::number(i);
+        auto addPhase = [&](const QString &name, qint64 from, qint64 to) {
+            if (from < 0 || to < from) {
+                return;
+            }
+            QJsonObject event = traceEvent("b", name, timing.category, from);
+            event["id"] = id;
+            events.append(event);
+            event = traceEvent("e", name, timing.category, to);
+            event["id"] = id;
+            events.append(event);
+        };
+
+        QJsonObject event = traceEvent("b", timing.method + " " + timing.path, timing.category, begin);
+        event["id"] = id;
+        event["args"] = QJsonObject { { "requestId", timing.requestId }, { "status", timing.statusCode },
+            { "attempt", timing.attempt }, { "wireBytes", timing.wireBytes }, { "decodedBytes", timing.decodedBytes },
+            { "parseUsecs", timing.parseUsecs } };
+        events.append(event);
+
+        addPhase("queued", timing.queuedAt, timing.startedAt);
+        const qint64 connected = timing.encryptedAt >= 0 ? timing.encryptedAt : timing.sentAt;
+        addPhase(timing.encryptedAt >= 0 ? "connect + TLS" : "connect", timing.connectingAt, connected);
+        addPhase("waiting", timing.sentAt, timing.firstByteAt);
+        addPhase("download", timing.firstByteAt, timing.finishedAt);
+
+        event = traceEvent("e", timing.method + " " + timing.path, timing.category, timing.finishedAt);
+        event["id"] = id;
+        events.append(event);
+    }
+
+    for (const Span &span : mSpans) {
+        if (span.start < 0 || span.end < span.start) {
+            continue;
+        }
+        QJsonObject event = traceEvent("X", span.name, "client", span.start);
+        event["dur"] = span.end - span.start;
+        event["args"] = QJsonObject { { "requestId", span.requestId } };
+        events.append(event);
+    }
+
+    return QJsonDocument(QJsonObject { { "traceEvents", events }, { "displayTimeUnit", "ms" } });
+}
+
+bool RequestMetrics::exportChromeTrace(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << Q_FUNC_INFO << "Unable to write" << fileName << file.errorString();
+        return false;
+    }
+    file.write(toChromeTrace().toJson(QJsonDocument::Compact));
+    return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "QGitlabAPI_global.h"
+
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QList>
+#include <QMetaType>
+#include <QString>
+
+namespace gitlab {
+
+/**
+ * @brief Timing of one request to the server.
+ *
+ * All timestamps are microseconds of RequestMetrics::now(). Phases that did not happen are -1, for example there is
+ * no connect and no TLS handshake, if an open connection was reused.
+ */
+struct QGITLABAPI_EXPORT RequestTiming {
+    int requestId = -1; /// ID returned by the public request function. Pages of one fetch share the ID
+    QString category; /// \see QGitlabClient::transferStats
+    QString method;
+    QString path;
+    int statusCode = 0;
+    int attempt = 0; /// 0 for the first try, counts up for retries
+
+    qint64 queuedAt = -1;
+    qint64 startedAt = -1; /// taken out of the queue and sent to QNetworkAccessManager
+    qint64 connectingAt = -1; /// DNS lookup and TCP connect started. Qt does not report when the lookup is done
+    qint64 encryptedAt = -1; /// TLS handshake done
+    qint64 sentAt = -1; /// request was written to the connection
+    qint64 firstByteAt = -1; /// reply headers arrived
+    qint64 finishedAt = -1;
+    qint64 parseUsecs = 0; /// time spent decompressing the reply. Parsing pages of issues shows up as "parse page" span
+
+    qint64 wireBytes = 0;
+    qint64 decodedBytes = 0;
+};
+
+/**
+ * @brief The RequestMetrics class collects the timing of the requests of a QGitlabClient, and of the work the users
+ * of the client did with the results (like inserting them into a model).
+ *
+ * Only the latest maxEntries() entries are kept. All entries can be exported as Chrome trace event JSON, that can be
+ * opened in chrome://tracing or https://ui.perfetto.dev
+ */
+class QGITLABAPI_EXPORT RequestMetrics
+{
+public:
+    /**
+     * @brief Work that is not a request, but belongs to one
+     */
+    struct Span {
+        QString name;
+        int requestId = -1;
+        qint64 start = -1;
+        qint64 end = -1;
+    };
+
+    RequestMetrics();
+
+    /**
+     * @brief now returns the current time in microseconds, the time base of all entries
+     */
+    qint64 now() const;
+
+    void addRequest(const RequestTiming &timing);
+    void addSpan(const QString &name, int requestId, qint64 start, qint64 end);
+
+    QList<RequestTiming> requests() const;
+    /**
+     * @brief requests returns the requests (pages, retries) that belong to one request ID
+     */
+    QList<RequestTiming> requests(int requestId) const;
+    QList<Span> spans() const;
+    void clear();
+
+    void setMaxEntries(int entries);
+    int maxEntries() const;
+
+    /**
+     * @brief toChromeTrace returns all entries in the Chrome trace event format
+     */
+    QJsonDocument toChromeTrace() const;
+    bool exportChromeTrace(const QString &fileName) const;
+
+private:
+    QElapsedTimer mClock;
+    QList<RequestTiming> mRequests;
+    QList<Span> mSpans;
+    int mMaxEntries = 10000;
+};
+
+}
+
+Q_DECLARE_METATYPE(gitlab::RequestTiming)
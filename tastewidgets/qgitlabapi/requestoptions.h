@@ -8,6 +8,9 @@ class RequestOptions
 {
 public:
     int mPage = 1; /// Number of the page to fetch. See pagination of gitlab API
+    int mPerPage = 100; /// Number of items per page. The gitlab maximum is 100
+    bool mKeysetPagination = false; /// Use keyset (cursor) pagination, following the "Link" header, instead of page
+                                    /// numbers. Fast for deep pages of large result sets
     int mProjectID = -1;
     /**
      * @brief queryData Creates query data for the URL
@@ -98,6 +98,28 @@ QUrl UrlComposer::composeEditIssueUrl(const int &projectID, const int &issueID,
     return url;
 }
 
+/*!
+ * \brief composeRelabelIssueUrl creates the url to add and remove labels of an issue, keeping all other labels
+ */
+QUrl UrlComposer::composeRelabelIssueUrl(
+        const int &projectID, const int &issueID, const QStringList &addLabels, const QStringList &removeLabels) const
+{
+    QString address = composeUrl(UrlComposer::UrlTypes::EditIssue);
+    address = address.arg(QString::number(projectID), QString::number(issueID));
+
+    QMap<QString, QVariant> data = { { "id", QString::number(projectID) }, { "issue_iid", QString::number(issueID) } };
+    if (!addLabels.isEmpty()) {
+        data.insert("add_labels", addLabels.join(","));
+    }
+    if (!removeLabels.isEmpty()) {
+        data.insert("remove_labels", removeLabels.join(","));
+    }
+
+    QUrl url(address);
+    url.setQuery(setQuery(data));
+    return url;
+}
+
 QUrl UrlComposer::composeProjectLabelsUrl(const LabelsRequestOptions &options) const
 {
     QString address = composeUrl(UrlComposer::UrlTypes::ProjectLabels);
@@ -121,6 +143,17 @@ QUrl UrlComposer::composeProjectUrl(const QString &projectName) const
     return url;
 }
 
+/*!
+ * \brief composeProjectByPathUrl creates the url to get a single project by its full path
+ * \param projectPath The path of the project including the namespace, like "group/subgroup/project"
+ */
+QUrl UrlComposer::composeProjectByPathUrl(const QString &projectPath) const
+{
+    QString address = composeUrl(UrlComposer::UrlTypes::Project);
+    address = address.arg(QString::fromLatin1(QUrl::toPercentEncoding(projectPath)));
+    return QUrl(address);
+}
+
 QUrl UrlComposer::composeGroupUrl(const QString &groupName) const
 {
     QString address = composeUrl(UrlComposer::UrlTypes::Projects);
@@ -144,6 +177,14 @@ QUrl UrlComposer::composeCreateProjectUrl(const QString &projectName, const QStr
     return url;
 }
 
+/*!
+ * \brief composeGraphQLUrl returns the url of the GraphQL endpoint of the server
+ */
+QUrl UrlComposer::composeGraphQLUrl() const
+{
+    return QUrl(composeUrl(UrlComposer::UrlTypes::GraphQL));
+}
+
 QString UrlComposer::composeUrl(UrlTypes target) const
 {
     QString address(mBaseURL.toString());
@@ -162,6 +203,10 @@ QString UrlComposer::composeUrl(UrlTypes target) const
         address += "/projects";
         break;
     }
+    case UrlComposer::UrlTypes::Project: {
+        address += "/projects/%1";
+        break;
+    }
     case UrlComposer::UrlTypes::Groups: {
         address += "/groups";
         break;
@@ -170,6 +215,12 @@ QString UrlComposer::composeUrl(UrlTypes target) const
         address += "/projects/%1/labels";
         break;
     }
+    case UrlComposer::UrlTypes::GraphQL: {
+        QUrl url(mBaseURL);
+        url.setPath("/api/graphql");
+        address = url.toString();
+        break;
+    }
     }
     return address;
 }
@@ -19,9 +19,11 @@ public:
         CreateIssue,
         EditIssue,
         Projects,
+        Project,
         Groups,
         CreateProject,
         ProjectLabels,
+        GraphQL,
     };
 
     UrlComposer();
@@ -34,11 +36,15 @@ public:
     QUrl composeEditIssueUrl(const int &projectID, const int &issueID, const QString &title = QString(),
             const QString &description = QString(), const QString &assignee = QString(),
             const QString &state_event = QString(), const QStringList &labels = QStringList()) const;
+    QUrl composeRelabelIssueUrl(const int &projectID, const int &issueID, const QStringList &addLabels,
+            const QStringList &removeLabels) const;
 
     QUrl composeProjectLabelsUrl(const LabelsRequestOptions &options) const;
     QUrl composeProjectUrl(const QString &projectName) const;
+    QUrl composeProjectByPathUrl(const QString &projectPath) const;
     QUrl composeGroupUrl(const QString &groupName) const;
     QUrl composeCreateProjectUrl(const QString &projectName, const QString &groupID) const;
+    QUrl composeGraphQLUrl() const;
 
     void setBaseURL(const QUrl &newBaseURL);
 
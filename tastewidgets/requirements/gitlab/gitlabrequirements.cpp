@@ -23,27 +23,37 @@ using namespace gitlab;
 
 namespace requirement {
 
-void GitLabRequirements::listOfIssues(const QList<gitlab::Issue> &issues)
+/*!
+ * Converts the \a issues to requirements. If \a closedIssues is set, closed issues and issues without the requirement
+ * label are not converted, but their IDs are added to \a closedIssues.
+ * Does not touch any object, so it can be run in any thread.
+ */
+QList<Requirement> GitLabRequirements::requirementsFromIssues(
+        const QList<gitlab::Issue> &issues, QList<int> *closedIssues)
 {
     QList<Requirement> requirements;
     requirements.reserve(issues.size());
     for (const auto &issue : issues) {
-        requirements.append(requirementFromIssue(issue));
+        if (closedIssues && (issue.state() == "closed" || !issue.labels().contains(k_requirementsTypeLabel))) {
+            closedIssues->append(issue.issueIID());
+        } else {
+            requirements.append(requirementFromIssue(issue));
+        }
     }
-    Q_EMIT listOfRequirements(requirements);
+    return requirements;
 }
 
 Requirement GitLabRequirements::requirementFromIssue(const gitlab::Issue &issue)
 {
-    QStringList tags = issue.mLabels;
+    QStringList tags = issue.labels();
     tags.removeAll(k_requirementsTypeLabel);
-    return { parseReqIfId(issue), issue.mTitle, issue.mDescription, issue.mIssueIID, tags, issue.mUrl };
+    return { parseReqIfId(issue), issue.title(), issue.description(), issue.issueIID(), tags, issue.url() };
 }
 
 QString GitLabRequirements::parseReqIfId(const gitlab::Issue &issue)
 {
     static const QString keyWord("#reqid");
-    for (const QString &line : issue.mDescription.split("\n")) {
+    for (const QString &line : issue.description().split("\n")) {
         QString id = line.trimmed();
         if (id.trimmed().startsWith(keyWord)) {
             id = id.sliced(keyWord.length());
@@ -62,7 +72,7 @@ QString GitLabRequirements::parseReqIfId(const gitlab::Issue &issue)
             return id;
         }
     }
-    return QString::number(issue.mIssueIID);
+    return QString::number(issue.issueIID());
 }
 
 /*!
@@ -21,24 +21,21 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 #include "label.h"
 #include "requirement.h"
 
-#include <QObject>
-
 namespace requirement {
 
 const static QString k_requirementsTypeLabel = "requirement";
 
-class GitLabRequirements : public QObject
+/*!
+ * \brief Converts Gitlab issues and labels to requirements and tags
+ */
+class GitLabRequirements
 {
-    Q_OBJECT
 public:
-    void listOfIssues(const QList<gitlab::Issue> &issues);
-
+    static QList<Requirement> requirementsFromIssues(
+            const QList<gitlab::Issue> &issues, QList<int> *closedIssues = nullptr);
     static Requirement requirementFromIssue(const gitlab::Issue &issue);
     static QString parseReqIfId(const gitlab::Issue &issue);
     static QStringList tagsFromLabels(const QList<gitlab::Label> &labels);
-
-Q_SIGNALS:
-    void listOfRequirements(const QList<Requirement> &);
 };
 
 }
@@ -23,6 +23,7 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 #include "qgitlabclient.h"
 
 #include <QDir>
+#include <utility>
 
 namespace requirement {
 
@@ -30,13 +31,7 @@ struct RequirementsManager::RequirementsManagerPrivate : public tracecommon::Iss
     RequirementsManagerPrivate(RequirementsManager::REPO_TYPE rType)
         : IssuesManagerPrivate(rType)
     {
-        switch (repoType) {
-        case REPO_TYPE::GITLAB:
-            gitlabRequirements = std::make_unique<requirement::GitLabRequirements>();
-        }
     }
-
-    std::unique_ptr<requirement::GitLabRequirements> gitlabRequirements;
 };
 
 RequirementsManager::RequirementsManager(REPO_TYPE repoType, QObject *parent)
@@ -46,19 +41,23 @@ RequirementsManager::RequirementsManager(REPO_TYPE repoType, QObject *parent)
     init(d.get());
     switch (d->repoType) {
     case (REPO_TYPE::GITLAB): {
-        connect(d->gitlabClient.get(), &gitlab::QGitlabClient::listOfIssues, d->gitlabRequirements.get(),
-                &requirement::GitLabRequirements::listOfIssues);
+        connect(d->gitlabClient.get(), &gitlab::QGitlabClient::listOfIssues, this,
+                [this](const QList<gitlab::Issue> &issues) { convertIssues(issues, d->incrementalFetch); });
         connect(d->gitlabClient.get(), &gitlab::QGitlabClient::issueCreated, this,
                 &RequirementsManager::requirementAdded);
         connect(d->gitlabClient.get(), &gitlab::QGitlabClient::issueClosed, this,
                 &RequirementsManager::requirementClosed);
-        connect(d->gitlabClient.get(), &gitlab::QGitlabClient::issueFetchingDone, this,
-                &RequirementsManager::fetchingRequirementsEnded);
+        connect(d->gitlabClient.get(), &gitlab::QGitlabClient::issueFetchingDone, this, [this]() {
+            afterBackgroundWork([this, deleted = std::exchange(d->deletedIssues, {})]() {
+                if (!deleted.isEmpty()) {
+                    Q_EMIT removedRequirements(deleted);
+                }
+                Q_EMIT fetchingRequirementsEnded();
+            });
+        });
         connect(d->gitlabClient.get(), &gitlab::QGitlabClient::listOfLabels, this, [this](QList<gitlab::Label> labels) {
             m_tagsBuffer.append(GitLabRequirements::tagsFromLabels(labels));
         });
-        connect(d->gitlabRequirements.get(), &requirement::GitLabRequirements::listOfRequirements, this,
-                &RequirementsManager::listOfRequirements);
         break;
     }
     default:
@@ -68,6 +67,31 @@ RequirementsManager::RequirementsManager(REPO_TYPE repoType, QObject *parent)
 
 RequirementsManager::~RequirementsManager() { }
 
+/*!
+ * Converts the \a issues to requirements in the background, and delivers them in the order the issues arrived.
+ * The issues of an \a incremental fetch are delivered as changed and removed requirements.
+ */
+void RequirementsManager::convertIssues(const QList<gitlab::Issue> &issues, bool incremental)
+{
+    runInBackground([this, issues, incremental]() -> std::function<void()> {
+        QList<int> closedIssues;
+        const QList<Requirement> requirements =
+                GitLabRequirements::requirementsFromIssues(issues, incremental ? &closedIssues : nullptr);
+        return [this, requirements, closedIssues, incremental]() {
+            if (!incremental) {
+                Q_EMIT listOfRequirements(requirements);
+                return;
+            }
+            if (!requirements.isEmpty()) {
+                Q_EMIT changedRequirements(requirements);
+            }
+            if (!closedIssues.isEmpty()) {
+                Q_EMIT removedRequirements(closedIssues);
+            }
+        };
+    });
+}
+
 /*!
  * Starts a request to load all requirements from the server. The requirements will be delivered by the
  * listOfRequirements signal.
@@ -80,10 +104,13 @@ bool RequirementsManager::requestAllRequirements()
         gitlab::IssueRequestOptions options;
         options.mProjectID = m_projectID;
         options.mLabels = { k_requirementsTypeLabel };
-        const bool wasBusy = d->gitlabClient->requestIssues(options);
-        if (wasBusy) {
-            return false;
-        }
+        options.mAdaptivePageSize = true;
+        cancelFetch();
+        d->incrementalFetch = false;
+        d->lastUpdatedAt = QDateTime();
+        d->issueCache.setKey(m_projectUrl, options.mLabels);
+        d->issueCache.clear();
+        d->fetchRequestId = d->gitlabClient->requestIssues(options);
         Q_EMIT startingFetchingRequirements();
         return true;
     }
@@ -93,6 +120,51 @@ bool RequirementsManager::requestAllRequirements()
     return false;
 }
 
+/*!
+ * Starts a request to load the requirements that were created, changed or closed since the last fetch.
+ * Changed requirements are delivered by the changedRequirements signal, closed ones by removedRequirements.
+ * Issues that lost the requirement label are removed as well. Every now and then all requirements are fetched
+ * instead, to find the ones that were deleted on the server.
+ * \return Returns true when everything went well.
+ */
+bool RequirementsManager::requestRequirementsUpdate()
+{
+    switch (d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        cancelFetch();
+        if (!d->lastUpdatedAt.isValid()) {
+            // Nothing fetched yet - show the issues cached on disk, and only ask for what changed since then
+            d->issueCache.setKey(m_projectUrl, { k_requirementsTypeLabel });
+            if (!d->issueCache.load()) {
+                return requestAllRequirements();
+            }
+            Q_EMIT startingFetchingRequirements();
+            convertIssues(d->issueCache.issues(), false);
+            d->lastUpdatedAt = d->issueCache.lastUpdatedAt();
+        }
+
+        gitlab::IssueRequestOptions options;
+        options.mProjectID = m_projectID;
+        if (needsFullSync()) {
+            // All open issues with the label. The ones that are not received anymore were deleted
+            options.mLabels = { k_requirementsTypeLabel };
+            options.mAdaptivePageSize = true;
+            d->fullSyncFetch = true;
+        } else {
+            // Without the label filter, so issues that lost the label are received (and removed) as well
+            options.mState = "all";
+            options.mUpdatedAfter = d->lastUpdatedAt;
+        }
+        d->incrementalFetch = true;
+        d->fetchRequestId = d->gitlabClient->requestIssues(options);
+        return true;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+    return false;
+}
+
 /*!
  * Creates a new requirement on the server
  * \param title The title of the requirement
@@ -108,8 +180,8 @@ bool RequirementsManager::createRequirement(
     case (REPO_TYPE::GITLAB): {
         const QString descr = QString("#reqid %1\n\n%2").arg(reqIfId, description);
         QStringList labels = { k_requirementsTypeLabel, testMethod };
-        const bool wasBusy = d->gitlabClient->createIssue(m_projectID, title, descr, labels);
-        return !wasBusy;
+        d->gitlabClient->createIssue(m_projectID, title, descr, labels);
+        return true;
     }
     default:
         qDebug() << "unknown repository type";
@@ -121,8 +193,43 @@ bool RequirementsManager::removeRequirement(const Requirement &requirement) cons
 {
     switch (d->repoType) {
     case (REPO_TYPE::GITLAB): {
-        const bool wasBusy = d->gitlabClient->closeIssue(m_projectID, requirement.m_issueID);
-        return !wasBusy;
+        d->gitlabClient->closeIssue(m_projectID, requirement.m_issueID);
+        return true;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+    return false;
+}
+
+bool RequirementsManager::removeRequirements(const QList<Requirement> &requirements) const
+{
+    switch (d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        QList<int> issueIDs;
+        for (const Requirement &requirement : requirements) {
+            issueIDs.append(requirement.m_issueID);
+        }
+        d->gitlabClient->closeIssues(m_projectID, issueIDs);
+        return true;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+    return false;
+}
+
+bool RequirementsManager::relabelRequirements(
+        const QList<Requirement> &requirements, const QStringList &addTags, const QStringList &removeTags) const
+{
+    switch (d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        QList<int> issueIDs;
+        for (const Requirement &requirement : requirements) {
+            issueIDs.append(requirement.m_issueID);
+        }
+        d->gitlabClient->relabelIssues(m_projectID, issueIDs, addTags, removeTags);
+        return true;
     }
     default:
         qDebug() << "unknown repository type";
@@ -22,6 +22,10 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #include <memory>
 
+namespace gitlab {
+class Issue;
+}
+
 namespace requirement {
 
 /*!
@@ -38,25 +42,47 @@ public:
 
     /*!
      * \brief Makes a request to retrieve all the requirements
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns true if the request was queued, otherwise false.
      */
     bool requestAllRequirements();
+    /*!
+     * \brief Makes a request to retrieve only the requirements that changed since the last fetch.
+     * If nothing was fetched yet, the issues cached on disk from the last session are delivered first. Without a
+     * cache it falls back to requestAllRequirements().
+     * \return Returns true if the request was queued, otherwise false.
+     */
+    bool requestRequirementsUpdate();
     /*!
      * \brief Makes a request to create requirement
      * \param title The title of the requirement
      * \param reqIfId The ID of the requirement (Not be confused with the Gitlab issue ID)
      * \param description The requiement's description
      * \param testMethod The test method of the requirement
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns true if the request was queued, otherwise false.
      */
     bool createRequirement(
             const QString &title, const QString &reqIfId, const QString &description, const QString &testMethod) const;
     /*!
      * \brief Removes a requirement
      * \param requirement Instance of the requirement object to be removed
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns true if the request was queued, otherwise false.
      */
     bool removeRequirement(const Requirement &requirement) const;
+    /*!
+     * \brief Removes a list of requirements. The end is reported by bulkChangeFinished
+     * \param requirements The requirements to be removed
+     * \return Returns true if the request was queued, otherwise false.
+     */
+    bool removeRequirements(const QList<Requirement> &requirements) const;
+    /*!
+     * \brief Adds and removes tags of a list of requirements. The end is reported by bulkChangeFinished
+     * \param requirements The requirements to change
+     * \param addTags Tags to add to each requirement
+     * \param removeTags Tags to remove from each requirement
+     * \return Returns true if the request was queued, otherwise false.
+     */
+    bool relabelRequirements(
+            const QList<Requirement> &requirements, const QStringList &addTags, const QStringList &removeTags) const;
 
 Q_SIGNALS:
     /*!
@@ -71,6 +97,14 @@ Q_SIGNALS:
      * \brief This signal carries the list of requirements fetched from Gitlab server
      */
     void listOfRequirements(const QList<requirement::Requirement> &);
+    /*!
+     * \brief This signal carries requirements that were added or changed since the last fetch
+     */
+    void changedRequirements(const QList<requirement::Requirement> &);
+    /*!
+     * \brief This signal carries the issue IDs of requirements that were closed since the last fetch
+     */
+    void removedRequirements(const QList<int> &issueIDs);
     /*!
      * \brief This signal is triggered when a Requirement is created
      */
@@ -81,6 +115,8 @@ Q_SIGNALS:
     void requirementClosed();
 
 private:
+    void convertIssues(const QList<gitlab::Issue> &issues, bool incremental);
+
     class RequirementsManagerPrivate;
     std::unique_ptr<RequirementsManagerPrivate> d;
 };
@@ -19,6 +19,8 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #include "requirementsmanager.h"
 
+#include <algorithm>
+
 using namespace tracecommon;
 
 namespace requirement {
@@ -31,6 +33,10 @@ RequirementsModelBase::RequirementsModelBase(RequirementsManager *manager, QObje
         connect(m_manager, &RequirementsManager::listOfRequirements, this, &RequirementsModelBase::addRequirements);
         connect(m_manager, &RequirementsManager::startingFetchingRequirements, this,
                 &RequirementsModelBase::clearRequirements);
+        connect(m_manager, &RequirementsManager::changedRequirements, this,
+                &RequirementsModelBase::updateRequirements);
+        connect(m_manager, &RequirementsManager::removedRequirements, this,
+                &RequirementsModelBase::removeRequirements);
     }
 }
 
@@ -46,6 +52,7 @@ void RequirementsModelBase::setRequirements(const QList<Requirement> &requiremen
 {
     beginResetModel();
     m_requirements = requirements;
+    rebuildIndexes();
     endResetModel();
 }
 
@@ -55,15 +62,82 @@ void RequirementsModelBase::setRequirements(const QList<Requirement> &requiremen
 void RequirementsModelBase::addRequirements(const QList<Requirement> &requirements)
 {
     QList<Requirement> reqs;
-
-    std::copy_if(requirements.begin(), requirements.end(), std::back_inserter(reqs),
-            [this](const Requirement &req) { return !m_requirements.contains(req); });
+    QSet<QString> newIds;
+    for (const Requirement &req : requirements) {
+        // Requirements are equal if their ReqIF ID is equal
+        if (!m_rowOfReqIfId.contains(req.m_id) && !newIds.contains(req.m_id)) {
+            newIds.insert(req.m_id);
+            reqs.append(req);
+        }
+    }
+    if (reqs.isEmpty()) {
+        return;
+    }
 
     beginInsertRows(QModelIndex(), m_requirements.size(), m_requirements.size() + reqs.size() - 1);
-    m_requirements.append(reqs);
+    m_requirements.reserve(m_requirements.size() + reqs.size());
+    for (const Requirement &req : std::as_const(reqs)) {
+        m_requirements.append(req);
+        indexRow(m_requirements.size() - 1);
+    }
     endInsertRows();
 }
 
+/*!
+ * Replaces the existing requirements that have the same issue ID as one of the given \a requirements.
+ * Requirements that are not in the model yet are appended.
+ */
+void RequirementsModelBase::updateRequirements(const QList<Requirement> &requirements)
+{
+    QList<Requirement> newRequirements;
+    for (const Requirement &requirement : requirements) {
+        const int row = rowOfIssue(requirement.m_issueID);
+        if (row < 0) {
+            newRequirements.append(requirement);
+            continue;
+        }
+        const bool idChanged = m_requirements[row].m_id != requirement.m_id;
+        m_requirements[row] = requirement;
+        if (idChanged) {
+            rebuildIndexes();
+        }
+        Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
+    }
+    addRequirements(newRequirements);
+}
+
+/*!
+ * Removes the requirements with the given \a issueIDs. Adjacent rows are removed together
+ */
+void RequirementsModelBase::removeRequirements(const QList<int> &issueIDs)
+{
+    QSet<int> rowSet;
+    for (int issueID : issueIDs) {
+        const int row = rowOfIssue(issueID);
+        if (row >= 0) {
+            rowSet.insert(row);
+        }
+    }
+    if (rowSet.isEmpty()) {
+        return;
+    }
+
+    // From the last row to the first one, so the rows that are still to be removed stay valid
+    QList<int> rows(rowSet.begin(), rowSet.end());
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    for (int i = 0; i < rows.size();) {
+        const int last = rows.at(i);
+        int first = last;
+        while (++i < rows.size() && rows.at(i) == first - 1) {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, last);
+        m_requirements.remove(first, last - first + 1);
+        endRemoveRows();
+    }
+    rebuildIndexes();
+}
+
 QVariant RequirementsModelBase::headerData(int section, Qt::Orientation orientation, int role) const
 {
     if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
@@ -120,7 +194,7 @@ QVariant RequirementsModelBase::data(const QModelIndex &index, int role) const
     }
 
     if (role == Qt::CheckStateRole && index.column() == CHECKED) {
-        return m_selectedRequirements.contains(getReqIfIdFromModelIndex(index)) ? Qt::Checked : Qt::Unchecked;
+        return m_selectedIds.contains(requirement.m_id) ? Qt::Checked : Qt::Unchecked;
     }
 
     if (role == RequirementsModelBase::RoleNames::ReqIfIdRole) {
@@ -149,24 +223,64 @@ QVariant RequirementsModelBase::data(const QModelIndex &index, int role) const
 bool RequirementsModelBase::setData(const QModelIndex &index, const QVariant &value, int role)
 {
     if (index.isValid() && role == Qt::CheckStateRole && index.column() == CHECKED) {
-        const QString requirementID = getReqIfIdFromModelIndex(index);
-        bool checked = value.toBool();
+        if (index.row() >= m_requirements.size()) {
+            return false;
+        }
+        const QString &requirementID = m_requirements.at(index.row()).m_id;
+        const bool checked = value.toBool();
+        if (checked == m_selectedIds.contains(requirementID)) {
+            return true;
+        }
         if (checked) {
+            m_selectedIds.insert(requirementID);
             m_selectedRequirements.append(requirementID);
         } else {
+            m_selectedIds.remove(requirementID);
             m_selectedRequirements.removeAll(requirementID);
         }
         emit dataChanged(index, index, { role });
+        Q_EMIT requirementChecked(requirementID, checked);
         return true;
     }
 
     return QAbstractTableModel::setData(index, value, role);
 }
 
-QString RequirementsModelBase::getReqIfIdFromModelIndex(const QModelIndex &index) const
+/*!
+ * Returns the row of the requirement with the gitlab issue ID \a issueID, or -1 if it is not in the model
+ */
+int RequirementsModelBase::rowOfIssue(int issueID) const
 {
-    auto idx = this->index(index.row(), REQUIREMENT_ID);
-    return this->data(idx, RequirementsModelBase::ReqIfIdRole).toString();
+    return m_rowOfIssue.value(issueID, -1);
+}
+
+/*!
+ * Adds the requirement in \a row to the indexes. If there are several requirements with the same ID, the indexes
+ * point to the first one
+ */
+void RequirementsModelBase::indexRow(int row)
+{
+    const Requirement &requirement = m_requirements.at(row);
+    if (!m_rowOfReqIfId.contains(requirement.m_id)) {
+        m_rowOfReqIfId.insert(requirement.m_id, row);
+    }
+    if (!m_rowOfIssue.contains(requirement.m_issueID)) {
+        m_rowOfIssue.insert(requirement.m_issueID, row);
+    }
+}
+
+/*!
+ * Creates the indexes by ReqIF ID and issue ID from scratch. Needed after rows were removed or IDs changed
+ */
+void RequirementsModelBase::rebuildIndexes()
+{
+    m_rowOfReqIfId.clear();
+    m_rowOfIssue.clear();
+    m_rowOfReqIfId.reserve(m_requirements.size());
+    m_rowOfIssue.reserve(m_requirements.size());
+    for (int row = 0; row < m_requirements.size(); ++row) {
+        indexRow(row);
+    }
 }
 
 Qt::ItemFlags RequirementsModelBase::flags(const QModelIndex &index) const
@@ -185,41 +299,69 @@ QStringList RequirementsModelBase::selectedRequirements() const
     return m_selectedRequirements;
 }
 
+/*!
+ * Replaces the selection by \a selected. Instead of a reset, one change of the check states is sent, covering the rows
+ * from the first to the last one whose check state changed.
+ */
 void RequirementsModelBase::setSelectedRequirements(const QStringList &selected)
 {
-    beginResetModel();
+    QSet<QString> selectedIds(selected.begin(), selected.end());
+    int minRow = -1;
+    int maxRow = -1;
+    for (int row = 0; row < m_requirements.size(); ++row) {
+        const QString &id = m_requirements.at(row).m_id;
+        if (m_selectedIds.contains(id) != selectedIds.contains(id)) {
+            if (minRow < 0) {
+                minRow = row;
+            }
+            maxRow = row;
+        }
+    }
+
     m_selectedRequirements = selected;
-    endResetModel();
+    m_selectedRequirements.removeDuplicates();
+    m_selectedIds.swap(selectedIds);
+
+    if (minRow >= 0) {
+        Q_EMIT dataChanged(index(minRow, CHECKED), index(maxRow, CHECKED), { Qt::CheckStateRole });
+    }
+}
+
+int RequirementsModelBase::issueIdOfRow(int row) const
+{
+    return m_requirements.at(row).m_issueID;
+}
+
+QStringList RequirementsModelBase::tagsOfRow(int row) const
+{
+    return m_requirements.at(row).m_tags;
+}
+
+QStringList RequirementsModelBase::textsOfRow(int row) const
+{
+    const Requirement &requirement = m_requirements.at(row);
+    return { requirement.m_description, requirement.m_longName };
+}
+
+bool RequirementsModelBase::isRowChecked(int row) const
+{
+    return m_selectedIds.contains(m_requirements.at(row).m_id);
 }
 
 Requirement RequirementsModelBase::requirementFromIndex(const QModelIndex &idx)
 {
-    QModelIndex _idx = index(idx.row(), RequirementsModelBase::REQUIREMENT_ID);
-    int issueID = _idx.data(RequirementsModelBase::IssueIdRole).toInt();
-    for (const auto &requirement : m_requirements) {
-        if (requirement.m_issueID == issueID) {
-            return requirement;
-        }
-    }
-    return Requirement();
+    return m_requirements.value(idx.row());
 }
 
 bool RequirementsModelBase::reqIfIDExists(const QString &reqIfID) const
 {
-    return std::any_of(m_requirements.begin(), m_requirements.end(),
-            [reqIfID](const Requirement &req) { return req.m_id == reqIfID; });
+    return m_rowOfReqIfId.contains(reqIfID);
 }
 
 Requirement RequirementsModelBase::requirementFromId(const QString &reqIfID) const
 {
-    auto it = std::find_if(m_requirements.begin(), m_requirements.end(),
-            [reqIfID](const Requirement &req) { return req.m_id == reqIfID; });
-
-    if (it != m_requirements.end()) {
-        return *it;
-    } else {
-        return Requirement();
-    }
+    const int row = m_rowOfReqIfId.value(reqIfID, -1);
+    return row >= 0 ? m_requirements.at(row) : Requirement();
 }
 
 } // namespace requirement
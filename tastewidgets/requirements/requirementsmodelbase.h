@@ -21,8 +21,10 @@ along with this program. If not, see
 #include "requirement.h"
 #include "tracecommonmodelbase.h"
 
+#include <QHash>
 #include <QList>
 #include <QPointer>
+#include <QSet>
 
 namespace requirement {
 
@@ -63,6 +65,16 @@ public:
      * \param requirements
      */
     virtual void addRequirements(const QList<requirement::Requirement> &requirements);
+    /*!
+     * \brief Updates existing requirements in place (matched by the issue ID) and appends the new ones
+     * \param requirements
+     */
+    virtual void updateRequirements(const QList<requirement::Requirement> &requirements);
+    /*!
+     * \brief Removes the requirements with the given issue IDs from the model
+     * \param issueIDs
+     */
+    virtual void removeRequirements(const QList<int> &issueIDs);
 
     // Header:
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
@@ -104,11 +116,27 @@ public:
      */
     Requirement requirementFromId(const QString &reqIfID) const;
 
+    int issueIdOfRow(int row) const override;
+    QStringList tagsOfRow(int row) const override;
+    QStringList textsOfRow(int row) const override;
+    bool isRowChecked(int row) const override;
+
+Q_SIGNALS:
+    /*!
+     * \brief Sent when the user checks or unchecks a requirement. Not sent for setSelectedRequirements
+     */
+    void requirementChecked(const QString &reqIfID, bool checked);
+
 protected:
-    QString getReqIfIdFromModelIndex(const QModelIndex &index) const;
+    int rowOfIssue(int issueID) const;
+    void indexRow(int row);
+    void rebuildIndexes();
 
     QList<Requirement> m_requirements;
-    QStringList m_selectedRequirements;
+    QHash<QString, int> m_rowOfReqIfId; /// row in m_requirements by ReqIF ID
+    QHash<int, int> m_rowOfIssue; /// row in m_requirements by issue ID
+    QStringList m_selectedRequirements; /// selected ReqIF IDs, in the order they were selected
+    QSet<QString> m_selectedIds; /// the same IDs, for fast lookup
     QPointer<RequirementsManager> m_manager;
 };
 
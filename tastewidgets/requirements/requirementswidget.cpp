@@ -40,17 +40,7 @@ RequirementsWidget::RequirementsWidget(QWidget *parent)
     , m_widgetBar(new tracecommon::WidgetBar(this))
 {
     ui->setupUi(this);
-    m_textFilterModel.setDynamicSortFilter(true);
-    m_textFilterModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
-    m_textFilterModel.setFilterKeyColumn(-1);
-
-    m_tagFilterModel.setDynamicSortFilter(true);
-    m_tagFilterModel.setSourceModel(&m_textFilterModel);
-
-    m_checkedModel.setFilterKeyColumn(RequirementsModelBase::CHECKED);
-    m_checkedModel.setSourceModel(&m_tagFilterModel);
-
-    ui->allRequirements->setModel(&m_tagFilterModel);
+    ui->allRequirements->setModel(&m_filterModel);
     ui->allRequirements->horizontalHeader()->setStretchLastSection(true);
     ui->allRequirements->setSortingEnabled(true);
 
@@ -66,8 +56,8 @@ RequirementsWidget::RequirementsWidget(QWidget *parent)
             &RequirementsWidget::onChangeOfCredentials);
     connect(ui->credentialWidget, &tracecommon::CredentialWidget::tokenChanged, this,
             &RequirementsWidget::onChangeOfCredentials);
-    connect(ui->filterLineEdit, &QLineEdit::textChanged, &m_textFilterModel,
-            &QSortFilterProxyModel::setFilterFixedString);
+    connect(ui->filterLineEdit, &QLineEdit::textChanged, &m_filterModel,
+            &tracecommon::TraceFilterProxyModel::setFilterText);
     connect(ui->filterButton, &QPushButton::clicked, this, &RequirementsWidget::toggleShowUsedRequirements);
 
     ui->filterButton->setIcon(QPixmap(":/tracecommonresources/icons/filter_icon.svg"));
@@ -85,6 +75,7 @@ void RequirementsWidget::setManager(RequirementsManager *manager)
     connect(m_reqManager, &RequirementsManager::projectIDChanged, this, &RequirementsWidget::updateProjectReady);
     connect(m_reqManager, &RequirementsManager::requirementAdded, this, &RequirementsWidget::requestRequirements);
     connect(m_reqManager, &RequirementsManager::requirementClosed, this, &RequirementsWidget::requestRequirements);
+    connect(m_reqManager, &RequirementsManager::bulkChangeFinished, this, &RequirementsWidget::requestRequirements);
     connect(m_reqManager, &RequirementsManager::busyChanged, this, &RequirementsWidget::updateServerStatus);
     connect(m_reqManager, &RequirementsManager::listOfTags, this, &RequirementsWidget::fillTagBar);
     connect(m_reqManager, &RequirementsManager::connectionError, this, [this](const QString &error) {
@@ -110,7 +101,7 @@ void RequirementsWidget::setManager(RequirementsManager *manager)
 void RequirementsWidget::setModel(RequirementsModelBase *model)
 {
     m_model = model;
-    m_textFilterModel.setSourceModel(m_model);
+    m_filterModel.setSourceModel(m_model);
 
     ui->allRequirements->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Interactive);
     ui->allRequirements->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Interactive);
@@ -119,14 +110,9 @@ void RequirementsWidget::setModel(RequirementsModelBase *model)
 
     connect(m_model, &requirement::RequirementsModelBase::rowsInserted, this,
             [this]() { ui->allRequirements->resizeRowsToContents(); });
-    connect(m_model, &requirement::RequirementsModelBase::dataChanged, [this](const QModelIndex &index) {
-        if (index.column() == RequirementsModelBase::CHECKED) {
-            bool isChecked = m_model->data(index, Qt::CheckStateRole).toBool();
-            QModelIndex reqID_index = m_model->index(index.row(), RequirementsModelBase::REQUIREMENT_ID);
-            QString ReqID = m_model->data(reqID_index, Qt::DisplayRole).toString();
-            Q_EMIT requirementSelected(ReqID, isChecked);
-        }
-    });
+    // Only changes by the user are reported, not the ones set by setSelectedRequirements
+    connect(m_model, &requirement::RequirementsModelBase::requirementChecked, this,
+            &RequirementsWidget::requirementSelected);
 }
 
 QUrl RequirementsWidget::url() const
@@ -183,8 +169,7 @@ void RequirementsWidget::requestRequirements()
     }
 
     if (m_reqManager && m_reqManager->hasValidProjectID()) {
-        m_model->clearRequirements();
-        m_reqManager->requestAllRequirements();
+        m_reqManager->requestRequirementsUpdate();
     }
 }
 
@@ -203,13 +188,13 @@ void RequirementsWidget::setLoginData()
         ui->serverStatusLabel->setPixmap({});
         return;
     }
-    m_model->clearRequirements();
     if (currUrl == m_reqManager->projectUrl() && currToken == m_reqManager->token()) {
-
-        m_reqManager->requestAllRequirements();
+        m_reqManager->requestRequirementsUpdate();
         return;
     }
 
+    m_model->clearRequirements();
+
     ui->serverStatusLabel->setToolTip(tr("Checking connection to the server"));
     m_reqManager->setCredentials(currUrl.toString(), currToken);
 }
@@ -262,11 +247,11 @@ void RequirementsWidget::openIssueLink(const QModelIndex &index)
 
 void RequirementsWidget::toggleShowUsedRequirements()
 {
-    if (ui->allRequirements->model() == &m_checkedModel) {
-        ui->allRequirements->setModel(&m_tagFilterModel);
+    if (m_filterModel.checkedFilter() == tracecommon::TraceFilterProxyModel::CheckedFilter::Checked) {
+        m_filterModel.setCheckedFilter(tracecommon::TraceFilterProxyModel::CheckedFilter::All);
         ui->filterButton->setIcon(QPixmap(":/tracecommonresources/icons/filter_icon.svg"));
     } else {
-        ui->allRequirements->setModel(&m_checkedModel);
+        m_filterModel.setCheckedFilter(tracecommon::TraceFilterProxyModel::CheckedFilter::Checked);
         ui->filterButton->setIcon(QPixmap(":/tracecommonresources/icons/disable_filter_icon.svg"));
     }
 }
@@ -275,7 +260,7 @@ void RequirementsWidget::fillTagBar(const QStringList &tags)
 {
     auto it = std::remove_if(m_tagButtons.begin(), m_tagButtons.end(), [this, tags](QToolButton *button) {
         if (!tags.contains(button->text())) {
-            m_tagFilterModel.removeTag(button->text());
+            m_filterModel.removeTag(button->text());
             button->deleteLater();
             return true;
         }
@@ -294,9 +279,9 @@ void RequirementsWidget::fillTagBar(const QStringList &tags)
                     return;
                 }
                 if (checked) {
-                    m_tagFilterModel.addTag(button->text());
+                    m_filterModel.addTag(button->text());
                 } else {
-                    m_tagFilterModel.removeTag(button->text());
+                    m_filterModel.removeTag(button->text());
                 }
             });
 
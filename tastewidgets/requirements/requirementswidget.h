@@ -17,9 +17,7 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #pragma once
 
-#include "checkedfilterproxymodel.h"
-#include "issuetextproxymodel.h"
-#include "tagfilterproxymodel.h"
+#include "tracefilterproxymodel.h"
 
 #include <QItemSelection>
 #include <QPointer>
@@ -115,9 +113,7 @@ private:
     tracecommon::WidgetBar *m_widgetBar;
     QPointer<RequirementsManager> m_reqManager;
     QPointer<requirement::RequirementsModelBase> m_model;
-    tracecommon::IssueTextProxyModel m_textFilterModel;
-    tracecommon::TagFilterProxyModel m_tagFilterModel;
-    CheckedFilterProxyModel m_checkedModel;
+    tracecommon::TraceFilterProxyModel m_filterModel;
 };
 
 }
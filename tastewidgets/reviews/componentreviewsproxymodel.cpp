@@ -19,6 +19,8 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #include "reviewsmodelbase.h"
 
+#include <algorithm>
+
 namespace reviews {
 
 ComponentReviewsProxyModel::ComponentReviewsProxyModel(reviews::ReviewsManager *manager, QObject *parent)
@@ -28,41 +30,144 @@ ComponentReviewsProxyModel::ComponentReviewsProxyModel(reviews::ReviewsManager *
 
 void ComponentReviewsProxyModel::setAcceptableIds(const QStringList &ids)
 {
-    m_ids = ids;
-    setReviews(m_originalReviews);
+    m_ids = QSet<QString>(ids.begin(), ids.end());
+    showReviews(filteredReviews());
 }
 
 void ComponentReviewsProxyModel::setReviews(const QList<reviews::Review> &reviews)
 {
-    beginResetModel();
     m_originalReviews = reviews;
-    m_reviews.clear();
+    showReviews(filteredReviews());
+}
+
+void ComponentReviewsProxyModel::addReviews(const QList<reviews::Review> &reviews)
+{
+    m_originalReviews.append(reviews);
     if (m_ids.isEmpty()) {
+        ReviewsModelBase::addReviews(reviews);
         m_reviews = m_originalReviews;
-    } else {
-        for (const reviews::Review &review : m_originalReviews) {
-            if (m_ids.contains(review.m_id)) {
-                m_reviews.append(review);
-            }
+        return;
+    }
+
+    QList<reviews::Review> acceptedReviews;
+    for (const reviews::Review &review : reviews) {
+        if (m_ids.contains(review.m_id)) {
+            acceptedReviews.append(review);
         }
     }
-    endResetModel();
+    ReviewsModelBase::addReviews(acceptedReviews);
 }
 
-void ComponentReviewsProxyModel::addReviews(const QList<reviews::Review> &reviews)
+void ComponentReviewsProxyModel::updateReviews(const QList<reviews::Review> &reviews)
+{
+    QHash<int, int> indexOfIssue;
+    indexOfIssue.reserve(m_originalReviews.size());
+    for (int i = m_originalReviews.size() - 1; i >= 0; --i) {
+        // Backwards, so the first review of an issue wins
+        indexOfIssue.insert(m_originalReviews.at(i).m_issueID, i);
+    }
+
+    for (const reviews::Review &review : reviews) {
+        const int i = indexOfIssue.value(review.m_issueID, -1);
+        if (i >= 0) {
+            m_originalReviews[i] = review;
+        } else {
+            indexOfIssue.insert(review.m_issueID, m_originalReviews.size());
+            m_originalReviews.append(review);
+        }
+    }
+    showReviews(filteredReviews());
+}
+
+void ComponentReviewsProxyModel::removeReviews(const QList<int> &issueIDs)
+{
+    const QSet<int> removedIssues(issueIDs.begin(), issueIDs.end());
+    m_originalReviews.removeIf(
+            [&removedIssues](const reviews::Review &review) { return removedIssues.contains(review.m_issueID); });
+    showReviews(filteredReviews());
+}
+
+/*!
+ * Returns the original reviews that pass the filter. Without a filter, those share the data with the original ones.
+ */
+QList<reviews::Review> ComponentReviewsProxyModel::filteredReviews() const
 {
-    beginResetModel();
-    m_originalReviews.append(reviews);
     if (m_ids.isEmpty()) {
-        m_reviews = m_originalReviews;
-    } else {
-        for (const reviews::Review &review : reviews) {
-            if (m_ids.contains(review.m_id) && !m_reviews.contains(review)) {
-                m_reviews.append(review);
+        return m_originalReviews;
+    }
+
+    QList<reviews::Review> reviews;
+    for (const reviews::Review &review : m_originalReviews) {
+        if (m_ids.contains(review.m_id)) {
+            reviews.append(review);
+        }
+    }
+    return reviews;
+}
+
+/*!
+ * Changes the shown reviews to \a reviews. Instead of resetting the model, only the rows that are gone are removed,
+ * the new ones are inserted and the changed ones are updated. So the views keep their selection and scroll position.
+ * The shown reviews and \a reviews are both in the order of the original reviews, so one pass over both is enough.
+ */
+void ComponentReviewsProxyModel::showReviews(const QList<reviews::Review> &reviews)
+{
+    QSet<int> shownIssues;
+    shownIssues.reserve(reviews.size());
+    for (const reviews::Review &review : reviews) {
+        shownIssues.insert(review.m_issueID);
+    }
+
+    // Remove the rows that are not shown anymore, range by range
+    for (int row = m_reviews.size() - 1; row >= 0; --row) {
+        if (shownIssues.contains(m_reviews.at(row).m_issueID)) {
+            continue;
+        }
+        const int last = row;
+        while (row > 0 && !shownIssues.contains(m_reviews.at(row - 1).m_issueID)) {
+            --row;
+        }
+        beginRemoveRows(QModelIndex(), row, last);
+        m_reviews.remove(row, last - row + 1);
+        endRemoveRows();
+    }
+
+    // Update the remaining rows, and insert the missing ones in between
+    int row = 0;
+    for (int i = 0; i < reviews.size();) {
+        if (row < m_reviews.size() && m_reviews.at(row).m_issueID == reviews.at(i).m_issueID) {
+            if (!(m_reviews.at(row) == reviews.at(i))) {
+                m_reviews[row] = reviews.at(i);
+                Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
             }
+            ++row;
+            ++i;
+            continue;
         }
+
+        const int nextShownIssue = row < m_reviews.size() ? m_reviews.at(row).m_issueID : -1;
+        int end = i + 1;
+        while (end < reviews.size() && reviews.at(end).m_issueID != nextShownIssue) {
+            ++end;
+        }
+        beginInsertRows(QModelIndex(), row, row + end - i - 1);
+        // Makes room in place (only the following rows are moved) and copies the new reviews into it
+        m_reviews.insert(row, end - i, reviews::Review());
+        std::copy(reviews.cbegin() + i, reviews.cbegin() + end, m_reviews.begin() + row);
+        endInsertRows();
+        row += end - i;
+        i = end;
     }
-    endResetModel();
+
+    // Left overs, in case the order of the reviews changed
+    if (row < m_reviews.size()) {
+        beginRemoveRows(QModelIndex(), row, m_reviews.size() - 1);
+        m_reviews.resize(row);
+        endRemoveRows();
+    }
+
+    // The content is the same now. Take over the list, to share the data (with the original reviews, if not filtered)
+    m_reviews = reviews;
 }
 
 bool ComponentReviewsProxyModel::reviewIDExists(const QString &revID) const
@@ -19,6 +19,8 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #include "reviewsmodelbase.h"
 
+#include <QSet>
+
 namespace reviews {
 
 /*!
@@ -40,11 +42,16 @@ public:
      */
     void setReviews(const QList<reviews::Review> &reviews) override;
     void addReviews(const QList<reviews::Review> &reviews) override;
+    void updateReviews(const QList<reviews::Review> &reviews) override;
+    void removeReviews(const QList<int> &issueIDs) override;
 
     bool reviewIDExists(const QString &revID) const override;
 
 protected:
-    QStringList m_ids;
+    QList<reviews::Review> filteredReviews() const;
+    void showReviews(const QList<reviews::Review> &reviews);
+
+    QSet<QString> m_ids;
     QList<reviews::Review> m_originalReviews;
 };
 
@@ -24,17 +24,22 @@ using namespace gitlab;
 namespace reviews {
 
 /*!
- * Converts the given list of Gitlab issues to a list Review and sends a siganl with those
+ * Converts Gitlab issues to reviews. Does not touch any object, so it can be run in any thread.
  * @param issues the list of Gitlab issues to convert
+ * @param closedIssues if set, closed issues and issues without the review label are not converted, but their IDs
+ *        are added to it
  */
-QList<Review> GitLabReviews::convertIssues(const QList<gitlab::Issue> &issues)
+QList<Review> GitLabReviews::reviewsFromIssues(const QList<gitlab::Issue> &issues, QList<int> *closedIssues)
 {
     QList<Review> reviews;
     reviews.reserve(issues.size());
     for (const auto &issue : issues) {
-        reviews.append(reviewFromIssue(issue));
+        if (closedIssues && (issue.state() == "closed" || !issue.labels().contains(k_reviewsTypeLabel))) {
+            closedIssues->append(issue.issueIID());
+        } else {
+            reviews.append(reviewFromIssue(issue));
+        }
     }
-    Q_EMIT listOfReviews(reviews);
     return reviews;
 }
 
@@ -44,16 +49,16 @@ QList<Review> GitLabReviews::convertIssues(const QList<gitlab::Issue> &issues)
  */
 Review GitLabReviews::reviewFromIssue(const gitlab::Issue &issue)
 {
-    QStringList tags = issue.mLabels;
+    QStringList tags = issue.labels();
     tags.removeAll(k_reviewsTypeLabel);
-    return Review { parseRevIfId(issue), issue.mTitle, issue.mDescription, issue.mAuthor, issue.mIssueIID, tags,
-        issue.mUrl };
+    return Review { parseRevIfId(issue), issue.title(), issue.description(), issue.author(), issue.issueIID(), tags,
+        issue.url() };
 }
 
 QString GitLabReviews::parseRevIfId(const gitlab::Issue &issue)
 {
     static const QString keyWord("#revid");
-    for (const QString &line : issue.mDescription.split("\n")) {
+    for (const QString &line : issue.description().split("\n")) {
         QString id = line.trimmed();
         if (id.trimmed().startsWith(keyWord)) {
             id = id.sliced(keyWord.length());
@@ -72,7 +77,7 @@ QString GitLabReviews::parseRevIfId(const gitlab::Issue &issue)
             return id;
         }
     }
-    return QString::number(issue.mIssueIID);
+    return QString::number(issue.issueIID());
 }
 
 /*!
@@ -21,27 +21,20 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 #include "label.h"
 #include "review.h"
 
-#include <QObject>
-
 namespace reviews {
 
 const static QString k_reviewsTypeLabel = "review";
 
 /*!
- * \brief The GitLabReviews class
+ * \brief Converts Gitlab issues and labels to reviews and tags
  */
-class GitLabReviews : public QObject
+class GitLabReviews
 {
-    Q_OBJECT
 public:
-    QList<Review> convertIssues(const QList<gitlab::Issue> &issues);
-
+    static QList<Review> reviewsFromIssues(const QList<gitlab::Issue> &issues, QList<int> *closedIssues = nullptr);
     static Review reviewFromIssue(const gitlab::Issue &issue);
     static QString parseRevIfId(const gitlab::Issue &issue);
     static QStringList tagsFromLabels(const QList<gitlab::Label> &labels);
-
-Q_SIGNALS:
-    void listOfReviews(const QList<Review> &);
 };
 
 }
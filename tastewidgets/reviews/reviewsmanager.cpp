@@ -21,19 +21,15 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 #include "issuerequestoptions.h"
 #include "issuesmanagerprivate.h"
 
+#include <utility>
+
 namespace reviews {
 
 struct ReviewsManager::ReviewsManagerPrivate : public tracecommon::IssuesManagerPrivate {
     ReviewsManagerPrivate(tracecommon::IssuesManager::REPO_TYPE rType)
         : IssuesManagerPrivate(rType)
     {
-        switch (repoType) {
-        case REPO_TYPE::GITLAB:
-            gitlabReviews = std::make_unique<reviews::GitLabReviews>();
-        }
     }
-
-    std::unique_ptr<reviews::GitLabReviews> gitlabReviews;
 };
 
 ReviewsManager::ReviewsManager(REPO_TYPE repoType, QObject *parent)
@@ -45,12 +41,17 @@ ReviewsManager::ReviewsManager(REPO_TYPE repoType, QObject *parent)
     switch (d->repoType) {
     case (REPO_TYPE::GITLAB): {
         connect(d->gitlabClient.get(), &gitlab::QGitlabClient::listOfIssues, this,
-                [this](const QList<gitlab::Issue> &issues) { Q_EMIT d->gitlabReviews->convertIssues(issues); });
-        connect(d->gitlabClient.get(), &gitlab::QGitlabClient::issueFetchingDone, this,
-                &ReviewsManager::fetchingReviewsEnded);
+                [this](const QList<gitlab::Issue> &issues) { convertIssues(issues, d->incrementalFetch); });
+        connect(d->gitlabClient.get(), &gitlab::QGitlabClient::issueFetchingDone, this, [this]() {
+            afterBackgroundWork([this, deleted = std::exchange(d->deletedIssues, {})]() {
+                if (!deleted.isEmpty()) {
+                    Q_EMIT removedReviews(deleted);
+                }
+                Q_EMIT fetchingReviewsEnded();
+            });
+        });
         connect(d->gitlabClient.get(), &gitlab::QGitlabClient::listOfLabels, this,
                 [this](QList<gitlab::Label> labels) { m_tagsBuffer.append(GitLabReviews::tagsFromLabels(labels)); });
-        connect(d->gitlabReviews.get(), &reviews::GitLabReviews::listOfReviews, this, &ReviewsManager::listOfReviews);
         connect(d->gitlabClient.get(), &gitlab::QGitlabClient::issueCreated, this, [this](const gitlab::Issue &issue) {
             Review newReview = GitLabReviews::reviewFromIssue(issue);
             Q_EMIT reviewAdded(newReview);
@@ -62,6 +63,30 @@ ReviewsManager::ReviewsManager(REPO_TYPE repoType, QObject *parent)
 
 ReviewsManager::~ReviewsManager() { }
 
+/*!
+ * Converts the \a issues to reviews in the background, and delivers them in the order the issues arrived.
+ * The issues of an \a incremental fetch are delivered as changed and removed reviews.
+ */
+void ReviewsManager::convertIssues(const QList<gitlab::Issue> &issues, bool incremental)
+{
+    runInBackground([this, issues, incremental]() -> std::function<void()> {
+        QList<int> closedIssues;
+        const QList<Review> reviews = GitLabReviews::reviewsFromIssues(issues, incremental ? &closedIssues : nullptr);
+        return [this, reviews, closedIssues, incremental]() {
+            if (!incremental) {
+                Q_EMIT listOfReviews(reviews);
+                return;
+            }
+            if (!reviews.isEmpty()) {
+                Q_EMIT changedReviews(reviews);
+            }
+            if (!closedIssues.isEmpty()) {
+                Q_EMIT removedReviews(closedIssues);
+            }
+        };
+    });
+}
+
 bool ReviewsManager::requestAllReviews()
 {
     switch (d->repoType) {
@@ -69,10 +94,13 @@ bool ReviewsManager::requestAllReviews()
         gitlab::IssueRequestOptions options;
         options.mProjectID = m_projectID;
         options.mLabels = { k_reviewsTypeLabel };
-        const bool wasBusy = d->gitlabClient->requestIssues(options);
-        if (wasBusy) {
-            return false;
-        }
+        options.mAdaptivePageSize = true;
+        cancelFetch();
+        d->incrementalFetch = false;
+        d->lastUpdatedAt = QDateTime();
+        d->issueCache.setKey(m_projectUrl, options.mLabels);
+        d->issueCache.clear();
+        d->fetchRequestId = d->gitlabClient->requestIssues(options);
         Q_EMIT startingFetchingReviews();
         return true;
     }
@@ -82,6 +110,50 @@ bool ReviewsManager::requestAllReviews()
     return false;
 }
 
+/*!
+ * Starts a request to load the reviews that were created, changed or closed since the last fetch.
+ * Changed reviews are delivered by the changedReviews signal, closed ones by removedReviews.
+ * Issues that lost the review label are removed as well. Every now and then all reviews are fetched
+ * instead, to find the ones that were deleted on the server.
+ */
+bool ReviewsManager::requestReviewsUpdate()
+{
+    switch (d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        cancelFetch();
+        if (!d->lastUpdatedAt.isValid()) {
+            // Nothing fetched yet - show the issues cached on disk, and only ask for what changed since then
+            d->issueCache.setKey(m_projectUrl, { k_reviewsTypeLabel });
+            if (!d->issueCache.load()) {
+                return requestAllReviews();
+            }
+            Q_EMIT startingFetchingReviews();
+            convertIssues(d->issueCache.issues(), false);
+            d->lastUpdatedAt = d->issueCache.lastUpdatedAt();
+        }
+
+        gitlab::IssueRequestOptions options;
+        options.mProjectID = m_projectID;
+        if (needsFullSync()) {
+            // All open issues with the label. The ones that are not received anymore were deleted
+            options.mLabels = { k_reviewsTypeLabel };
+            options.mAdaptivePageSize = true;
+            d->fullSyncFetch = true;
+        } else {
+            // Without the label filter, so issues that lost the label are received (and removed) as well
+            options.mState = "all";
+            options.mUpdatedAfter = d->lastUpdatedAt;
+        }
+        d->incrementalFetch = true;
+        d->fetchRequestId = d->gitlabClient->requestIssues(options);
+        return true;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+    return false;
+}
+
 bool ReviewsManager::createReview(
         const QString &title, const QString &revId, const QString &description, const QString &method) const
 {
@@ -89,8 +161,8 @@ bool ReviewsManager::createReview(
     case (REPO_TYPE::GITLAB): {
         const QString descr = QString("#revid %1\n\n%2").arg(revId, description);
         QStringList labels = { k_reviewsTypeLabel, method };
-        const bool wasBusy = d->gitlabClient->createIssue(m_projectID, title, descr, labels);
-        return !wasBusy;
+        d->gitlabClient->createIssue(m_projectID, title, descr, labels);
+        return true;
     }
     default:
         qDebug() << "unknown repository type";
@@ -102,8 +174,43 @@ bool ReviewsManager::removeReview(const Review &review) const
 {
     switch (d->repoType) {
     case (REPO_TYPE::GITLAB): {
-        const bool wasBusy = d->gitlabClient->closeIssue(m_projectID, review.m_issueID);
-        return !wasBusy;
+        d->gitlabClient->closeIssue(m_projectID, review.m_issueID);
+        return true;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+    return false;
+}
+
+bool ReviewsManager::removeReviews(const QList<Review> &reviews) const
+{
+    switch (d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        QList<int> issueIDs;
+        for (const Review &review : reviews) {
+            issueIDs.append(review.m_issueID);
+        }
+        d->gitlabClient->closeIssues(m_projectID, issueIDs);
+        return true;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+    return false;
+}
+
+bool ReviewsManager::relabelReviews(
+        const QList<Review> &reviews, const QStringList &addTags, const QStringList &removeTags) const
+{
+    switch (d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        QList<int> issueIDs;
+        for (const Review &review : reviews) {
+            issueIDs.append(review.m_issueID);
+        }
+        d->gitlabClient->relabelIssues(m_projectID, issueIDs, addTags, removeTags);
+        return true;
     }
     default:
         qDebug() << "unknown repository type";
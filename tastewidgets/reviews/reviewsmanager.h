@@ -22,6 +22,10 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #include <memory>
 
+namespace gitlab {
+class Issue;
+}
+
 namespace reviews {
 
 /*!
@@ -37,34 +41,59 @@ public:
 
     /*!
      * \brief Makes a request to retrieve all the reviews
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns true if the request was queued, otherwise false.
      */
     bool requestAllReviews();
+    /*!
+     * \brief Makes a request to retrieve only the reviews that changed since the last fetch.
+     * If nothing was fetched yet, the issues cached on disk from the last session are delivered first. Without a
+     * cache it falls back to requestAllReviews().
+     * \return Returns true if the request was queued, otherwise false.
+     */
+    bool requestReviewsUpdate();
     /*!
      * \brief Makes a request to create review
      * \param title The title of the review
      * \param revId the ID of the review (Not be confused with the Gitlab issue ID)
      * \param description The reviews's  full description
      * \param method The test method / criticality of the review
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns true if the request was queued, otherwise false.
      */
     bool createReview(
             const QString &title, const QString &revId, const QString &description, const QString &method) const;
     /*!
      * \brief Removes a review
      * \param review Instance of the review object to be removed
-     * \return Returns true if there's a pending request otherwise false.
+     * \return Returns true if the request was queued, otherwise false.
      */
     bool removeReview(const Review &review) const;
+    /*!
+     * \brief Removes a list of reviews. The end is reported by bulkChangeFinished
+     * \param reviews The reviews to be removed
+     * \return Returns true if the request was queued, otherwise false.
+     */
+    bool removeReviews(const QList<Review> &reviews) const;
+    /*!
+     * \brief Adds and removes tags of a list of reviews. The end is reported by bulkChangeFinished
+     * \param reviews The reviews to change
+     * \param addTags Tags to add to each review
+     * \param removeTags Tags to remove from each review
+     * \return Returns true if the request was queued, otherwise false.
+     */
+    bool relabelReviews(const QList<Review> &reviews, const QStringList &addTags, const QStringList &removeTags) const;
 
 Q_SIGNALS:
     void startingFetchingReviews();
     void fetchingReviewsEnded();
     void listOfReviews(const QList<reviews::Review> &);
+    void changedReviews(const QList<reviews::Review> &);
+    void removedReviews(const QList<int> &issueIDs);
     void reviewAdded(const Review &review);
     void reviewClosed();
 
 private:
+    void convertIssues(const QList<gitlab::Issue> &issues, bool incremental);
+
     class ReviewsManagerPrivate;
     std::unique_ptr<ReviewsManagerPrivate> d;
 };
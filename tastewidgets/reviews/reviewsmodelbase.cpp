@@ -19,6 +19,10 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #include "reviewsmanager.h"
 
+#include <QSet>
+
+#include <algorithm>
+
 using namespace tracecommon;
 
 namespace reviews {
@@ -30,6 +34,8 @@ ReviewsModelBase::ReviewsModelBase(ReviewsManager *manager, QObject *parent)
     if (m_manager != nullptr) {
         connect(m_manager, &ReviewsManager::listOfReviews, this, &ReviewsModelBase::addReviews);
         connect(m_manager, &ReviewsManager::startingFetchingReviews, this, &ReviewsModelBase::clearReviews);
+        connect(m_manager, &ReviewsManager::changedReviews, this, &ReviewsModelBase::updateReviews);
+        connect(m_manager, &ReviewsManager::removedReviews, this, &ReviewsModelBase::removeReviews);
     }
 }
 
@@ -53,11 +59,83 @@ void ReviewsModelBase::setReviews(const QList<Review> &reviews)
  */
 void ReviewsModelBase::addReviews(const QList<Review> &reviews)
 {
+    if (reviews.isEmpty()) {
+        return;
+    }
+
     beginInsertRows(QModelIndex(), m_reviews.size(), m_reviews.size() + reviews.size() - 1);
     m_reviews.append(reviews);
     endInsertRows();
 }
 
+/*!
+ * Replaces the existing reviews that have the same issue ID as one of the given \a reviews.
+ * Reviews that are not in the model yet are appended.
+ */
+void ReviewsModelBase::updateReviews(const QList<Review> &reviews)
+{
+    const QHash<int, int> rowOfIssue = rowsOfIssues();
+    QList<Review> newReviews;
+    for (const Review &review : reviews) {
+        const int row = rowOfIssue.value(review.m_issueID, -1);
+        if (row < 0) {
+            newReviews.append(review);
+            continue;
+        }
+        m_reviews[row] = review;
+        Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
+    }
+    addReviews(newReviews);
+}
+
+/*!
+ * Removes the reviews with the given \a issueIDs. Adjacent rows are removed together
+ */
+void ReviewsModelBase::removeReviews(const QList<int> &issueIDs)
+{
+    const QHash<int, int> rowOfIssue = rowsOfIssues();
+    QSet<int> rowSet;
+    for (int issueID : issueIDs) {
+        const int row = rowOfIssue.value(issueID, -1);
+        if (row >= 0) {
+            rowSet.insert(row);
+        }
+    }
+    if (rowSet.isEmpty()) {
+        return;
+    }
+
+    // From the last row to the first one, so the rows that are still to be removed stay valid
+    QList<int> rows(rowSet.begin(), rowSet.end());
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    for (int i = 0; i < rows.size();) {
+        const int last = rows.at(i);
+        int first = last;
+        while (++i < rows.size() && rows.at(i) == first - 1) {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, last);
+        m_reviews.remove(first, last - first + 1);
+        endRemoveRows();
+    }
+}
+
+/*!
+ * Returns the rows of all reviews, by their gitlab issue ID. If there are several reviews of the same issue, the row
+ * of the first one is returned
+ */
+QHash<int, int> ReviewsModelBase::rowsOfIssues() const
+{
+    QHash<int, int> rows;
+    rows.reserve(m_reviews.size());
+    for (int row = 0; row < m_reviews.size(); ++row) {
+        if (!rows.contains(m_reviews.at(row).m_issueID)) {
+            rows.insert(m_reviews.at(row).m_issueID, row);
+        }
+    }
+    return rows;
+}
+
 QVariant ReviewsModelBase::headerData(int section, Qt::Orientation orientation, int role) const
 {
     if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
@@ -131,6 +209,22 @@ QVariant ReviewsModelBase::data(const QModelIndex &index, int role) const
     return QVariant();
 }
 
+int ReviewsModelBase::issueIdOfRow(int row) const
+{
+    return m_reviews.at(row).m_issueID;
+}
+
+QStringList ReviewsModelBase::tagsOfRow(int row) const
+{
+    return m_reviews.at(row).m_tags;
+}
+
+QStringList ReviewsModelBase::textsOfRow(int row) const
+{
+    const Review &review = m_reviews.at(row);
+    return { review.m_description, review.m_longName, review.m_author };
+}
+
 Review ReviewsModelBase::reviewFromIndex(const QModelIndex &idx) const
 {
     int issueID = idx.data(ReviewsModelBase::IssueIdRole).toInt();
@@ -21,6 +21,7 @@ along with this program. If not, see
 #include "review.h"
 #include "tracecommonmodelbase.h"
 
+#include <QHash>
 #include <QList>
 #include <QPointer>
 
@@ -66,6 +67,16 @@ public:
      * \param reviews Reviews to add to the model
      */
     virtual void addReviews(const QList<Review> &reviews);
+    /*!
+     * \brief Updates existing reviews in place (matched by the issue ID) and appends the new ones
+     * \param reviews Reviews that were added or changed
+     */
+    virtual void updateReviews(const QList<Review> &reviews);
+    /*!
+     * \brief Removes the reviews with the given issue IDs from the model
+     * \param issueIDs Issue IDs of the reviews to remove
+     */
+    virtual void removeReviews(const QList<int> &issueIDs);
 
     // Header:
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
@@ -85,7 +96,13 @@ public:
      */
     virtual bool reviewIDExists(const QString &revID) const;
 
+    int issueIdOfRow(int row) const override;
+    QStringList tagsOfRow(int row) const override;
+    QStringList textsOfRow(int row) const override;
+
 protected:
+    QHash<int, int> rowsOfIssues() const;
+
     QList<Review> m_reviews;
     QPointer<ReviewsManager> m_manager;
 };
@@ -41,15 +41,6 @@ ReviewsWidget::ReviewsWidget(QWidget *parent)
     ui->setupUi(this);
     ui->removeReviewButton->setEnabled(false);
 
-    m_textFilterModel.setDynamicSortFilter(true);
-    m_textFilterModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
-    m_textFilterModel.setFilterKeyColumn(-1);
-
-    m_tagFilterModel.setDynamicSortFilter(true);
-    m_tagFilterModel.setSourceModel(&m_textFilterModel);
-
-
-
     connect(ui->refreshButton, &QPushButton::clicked, this, &ReviewsWidget::setLoginData);
     connect(ui->credentialWidget, &tracecommon::CredentialWidget::urlChanged, this,
             &ReviewsWidget::onChangeOfCredentials);
@@ -58,8 +49,8 @@ ReviewsWidget::ReviewsWidget(QWidget *parent)
     connect(ui->allReviews, &QTableView::doubleClicked, this, &ReviewsWidget::openIssueLink);
     connect(ui->createReviewButton, &QPushButton::clicked, this, &ReviewsWidget::showNewReviewDialog);
     connect(ui->removeReviewButton, &QPushButton::clicked, this, &ReviewsWidget::removeReview);
-    connect(ui->filterLineEdit, &QLineEdit::textChanged, &m_textFilterModel,
-            &QSortFilterProxyModel::setFilterFixedString);
+    connect(ui->filterLineEdit, &QLineEdit::textChanged, &m_filterModel,
+            &tracecommon::TraceFilterProxyModel::setFilterText);
 
     ui->verticalLayout->insertWidget(0, m_widgetBar);
 }
@@ -82,6 +73,7 @@ void ReviewsWidget::setManager(ReviewsManager *manager)
     connect(m_reviewsManager, &ReviewsManager::busyChanged, this, &ReviewsWidget::updateServerStatus);
     connect(m_reviewsManager, &ReviewsManager::reviewAdded, this, &ReviewsWidget::reviewAdded);
     connect(m_reviewsManager, &ReviewsManager::reviewAdded, this, &ReviewsWidget::requestReviews);
+    connect(m_reviewsManager, &ReviewsManager::bulkChangeFinished, this, &ReviewsWidget::requestReviews);
     connect(m_reviewsManager, &ReviewsManager::fetchingReviewsEnded, m_reviewsManager, &ReviewsManager::requestTags);
     connect(m_reviewsManager, &ReviewsManager::listOfTags, this, &ReviewsWidget::fillTagBar);
     connect(m_reviewsManager, &tracecommon::IssuesManager::projectUrlChanged, ui->credentialWidget,
@@ -103,9 +95,8 @@ void ReviewsWidget::setManager(ReviewsManager *manager)
 void ReviewsWidget::setModel(ReviewsModelBase *model)
 {
     m_model = model;
-    m_textFilterModel.setSourceModel(m_model);
-    // Note: m_tagFilterModel uses m_textFilterModel as source model
-    ui->allReviews->setModel(&m_tagFilterModel);
+    m_filterModel.setSourceModel(m_model);
+    ui->allReviews->setModel(&m_filterModel);
 }
 
 void ReviewsWidget::setAcceptableIds(const QStringList &ids)
@@ -164,7 +155,7 @@ void ReviewsWidget::setLoginData()
     }
 
     if (currUrl == m_reviewsManager->projectUrl() && currToken == m_reviewsManager->token()) {
-        m_reviewsManager->requestAllReviews();
+        m_reviewsManager->requestReviewsUpdate();
         return;
     }
 
@@ -234,7 +225,7 @@ void ReviewsWidget::onChangeOfCredentials()
 void ReviewsWidget::requestReviews()
 {
     if (m_reviewsManager && m_reviewsManager->hasValidProjectID()) {
-        m_reviewsManager->requestAllReviews();
+        m_reviewsManager->requestReviewsUpdate();
     }
 }
 
@@ -282,7 +273,7 @@ void ReviewsWidget::fillTagBar(const QStringList &tags)
 {
     auto it = std::remove_if(m_tagButtons.begin(), m_tagButtons.end(), [this, tags](QToolButton *button) {
         if (!tags.contains(button->text())) {
-            m_tagFilterModel.removeTag(button->text());
+            m_filterModel.removeTag(button->text());
             button->deleteLater();
             return true;
         }
@@ -303,9 +294,9 @@ void ReviewsWidget::fillTagBar(const QStringList &tags)
                     return;
                 }
                 if (checked) {
-                    m_tagFilterModel.addTag(button->text());
+                    m_filterModel.addTag(button->text());
                 } else {
-                    m_tagFilterModel.removeTag(button->text());
+                    m_filterModel.removeTag(button->text());
                 }
             });
 
@@ -18,8 +18,7 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 #pragma once
 
 #include "componentreviewsproxymodel.h"
-#include "issuetextproxymodel.h"
-#include "tagfilterproxymodel.h"
+#include "tracefilterproxymodel.h"
 
 #include <QList>
 #include <QPointer>
@@ -113,8 +112,7 @@ protected:
     tracecommon::WidgetBar *m_widgetBar;
     QPointer<ReviewsManager> m_reviewsManager;
     QPointer<ReviewsModelBase> m_model;
-    tracecommon::IssueTextProxyModel m_textFilterModel;
-    tracecommon::TagFilterProxyModel m_tagFilterModel;
+    tracecommon::TraceFilterProxyModel m_filterModel;
     ComponentReviewsProxyModel *m_reviewsModel;
 };
 
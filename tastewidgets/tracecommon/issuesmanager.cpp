@@ -22,9 +22,15 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 #include "qgitlabclient.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 namespace tracecommon {
 
+static const int kFullSyncIntervalSecs = 15 * 60; /// maximum time between two fetches of all issues
+
 IssuesManager::IssuesManager(QObject *parent)
     : QObject { parent }
 {
@@ -43,8 +49,13 @@ bool IssuesManager::setCredentials(const QString &url, const QString &token)
         return true;
     }
 
+    // Results of the old project must not end up in the models of the new one
+    cancelAllRequests();
+
     m_projectUrl = url;
     m_token = token;
+    m_d->lastUpdatedAt = QDateTime();
+    m_d->lastFullSyncAt = QDateTime();
     setProjectID(-1);
 
     Q_EMIT projectUrlChanged(m_projectUrl);
@@ -54,15 +65,21 @@ bool IssuesManager::setCredentials(const QString &url, const QString &token)
         return false;
     }
 
+    // The token is never sent in cleartext. Plain http is only kept for local servers (like the benchmark stub)
+    const QUrl projectUrl(url);
+    const QHostAddress hostAddress(projectUrl.host());
+    const bool isLoopback = projectUrl.host() == "localhost" || hostAddress.isLoopback();
     QUrl _url;
-    _url.setScheme("https");
-    _url.setHost(QUrl(url).host());
-    _url.setPath("/api/v4/");
+    _url.setScheme(isLoopback && projectUrl.scheme() == "http" ? "http" : "https");
+    _url.setHost(projectUrl.host());
+    if (isLoopback) {
+        _url.setPort(projectUrl.port());
+    }
 
     switch (m_d->repoType) {
 
     case (REPO_TYPE::GITLAB):
-        m_d->gitlabClient->setCredentials(_url.scheme() + "://" + _url.host(), token);
+        m_d->gitlabClient->setCredentials(_url.toString(), token);
     }
     return requestProjectID(url);
 }
@@ -117,11 +134,11 @@ bool IssuesManager::requestTags()
     case (REPO_TYPE::GITLAB): {
         gitlab::LabelsRequestOptions options;
         options.mProjectID = m_projectID;
-        const bool wasBusy = m_d->gitlabClient->requestListofLabels(options);
-        if (wasBusy) {
-            return false;
-        }
         m_tagsBuffer.clear();
+        if (m_d->tagsRequestId >= 0) {
+            m_d->gitlabClient->cancelRequest(m_d->tagsRequestId);
+        }
+        m_d->tagsRequestId = m_d->gitlabClient->requestListofLabels(options);
         return true;
     }
     default:
@@ -135,6 +152,29 @@ QStringList IssuesManager::tagsBuffer()
     return m_tagsBuffer;
 }
 
+bool IssuesManager::exportRequestTrace(const QString &fileName) const
+{
+    switch (m_d->repoType) {
+    case (REPO_TYPE::GITLAB):
+        return m_d->gitlabClient->metrics().exportChromeTrace(fileName);
+    default:
+        qDebug() << "unknown repository type";
+    }
+    return false;
+}
+
+void IssuesManager::setUseGraphQL(bool useGraphQL)
+{
+    switch (m_d->repoType) {
+    case (REPO_TYPE::GITLAB):
+        m_d->gitlabClient->setFetchBackend(useGraphQL ? gitlab::QGitlabClient::GraphQLBackend
+                                                      : gitlab::QGitlabClient::RestBackend);
+        break;
+    default:
+        qDebug() << "unknown repository type";
+    }
+}
+
 void IssuesManager::setProjectID(const int &newProjectID)
 {
     if (m_projectID == newProjectID) {
@@ -155,8 +195,95 @@ void IssuesManager::init(IssuesManagerPrivate *priv)
         connect(m_d->gitlabClient.get(), &gitlab::QGitlabClient::busyStateChanged, this, &IssuesManager::busyChanged);
         connect(m_d->gitlabClient.get(), &gitlab::QGitlabClient::requestedProjectID, this,
                 &IssuesManager::setProjectID);
-        connect(m_d->gitlabClient.get(), &gitlab::QGitlabClient::labelsFetchingDone, this,
-                [this] { Q_EMIT listOfTags(m_tagsBuffer); });
+        connect(m_d->gitlabClient.get(), &gitlab::QGitlabClient::labelsFetchingDone, this, [this] {
+            m_d->tagsRequestId = -1;
+            Q_EMIT listOfTags(m_tagsBuffer);
+        });
+        connect(m_d->gitlabClient.get(), &gitlab::QGitlabClient::listOfIssues, this,
+                [this](const QList<gitlab::Issue> &issues) {
+                    for (const gitlab::Issue &issue : issues) {
+                        if (!m_d->fetchUpdatedAt.isValid() || issue.updatedAt() > m_d->fetchUpdatedAt) {
+                            m_d->fetchUpdatedAt = issue.updatedAt();
+                        }
+                        if (m_d->fullSyncFetch) {
+                            m_d->fetchedIssues.insert(issue.issueIID());
+                        }
+                    }
+                    m_d->issueCache.updateIssues(issues);
+                });
+        connect(m_d->gitlabClient.get(), &gitlab::QGitlabClient::issueFetchingDone, this, [this] {
+            // Only a complete fetch is a valid base for incremental updates
+            if (m_d->fetchUpdatedAt.isValid()
+                    && (!m_d->lastUpdatedAt.isValid() || m_d->fetchUpdatedAt > m_d->lastUpdatedAt)) {
+                m_d->lastUpdatedAt = m_d->fetchUpdatedAt;
+            }
+            m_d->fetchUpdatedAt = QDateTime();
+            m_d->fetchRequestId = -1;
+            if (m_d->fullSyncFetch) {
+                // Issues that were not received anymore were deleted on the server
+                m_d->deletedIssues.clear();
+                for (int issueIID : m_d->issueCache.issueIIDs()) {
+                    if (!m_d->fetchedIssues.contains(issueIID)) {
+                        m_d->deletedIssues.append(issueIID);
+                    }
+                }
+                m_d->issueCache.removeIssues(m_d->deletedIssues);
+                m_d->fetchedIssues.clear();
+                m_d->fullSyncFetch = false;
+                m_d->lastFullSyncAt = QDateTime::currentDateTimeUtc();
+            } else if (!m_d->incrementalFetch) {
+                m_d->lastFullSyncAt = QDateTime::currentDateTimeUtc();
+            }
+            m_d->issueCache.save();
+        });
+        connect(m_d->gitlabClient.get(), &gitlab::QGitlabClient::batchFinished, this,
+                [this](int, const QList<int> &failedIssueIDs) { Q_EMIT bulkChangeFinished(failedIssueIDs); });
+        break;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+}
+
+/*!
+ * Cancels the running fetch of issues (if any). Its results are dropped.
+ */
+void IssuesManager::cancelFetch()
+{
+    switch (m_d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        if (m_d->fetchRequestId >= 0) {
+            m_d->gitlabClient->cancelRequest(m_d->fetchRequestId);
+            m_d->fetchRequestId = -1;
+        }
+        m_d->fetchUpdatedAt = QDateTime();
+        m_d->fullSyncFetch = false;
+        m_d->fetchedIssues.clear();
+        // Drop the results of the work that is still running in the background
+        m_d->finishedJobs.clear();
+        m_d->nextJobToDeliver = m_d->nextJob;
+        break;
+    }
+    default:
+        qDebug() << "unknown repository type";
+    }
+}
+
+/*!
+ * Cancels all running requests for the current project: issues, tags and the project ID
+ */
+void IssuesManager::cancelAllRequests()
+{
+    cancelFetch();
+
+    switch (m_d->repoType) {
+    case (REPO_TYPE::GITLAB): {
+        for (int *requestId : { &m_d->tagsRequestId, &m_d->projectIdRequestId }) {
+            if (*requestId >= 0) {
+                m_d->gitlabClient->cancelRequest(*requestId);
+                *requestId = -1;
+            }
+        }
         break;
     }
     default:
@@ -164,12 +291,93 @@ void IssuesManager::init(IssuesManagerPrivate *priv)
     }
 }
 
+/*!
+ * Runs \a work (like converting fetched issues) in the global thread pool. The function returned by \a work is then
+ * run in the thread of the manager (to insert the results into the models). Those are run in the order the work was
+ * started. Work that was started before the fetch was cancelled is dropped.
+ */
+void IssuesManager::runInBackground(const std::function<std::function<void()>()> &work)
+{
+    const int job = m_d->nextJob++;
+    const int requestId = m_d->fetchRequestId;
+    gitlab::RequestMetrics *metrics = nullptr;
+    switch (m_d->repoType) {
+    case (REPO_TYPE::GITLAB):
+        metrics = &m_d->gitlabClient->metrics();
+        break;
+    default:
+        break;
+    }
+    const qint64 scheduledAt = metrics ? metrics->now() : 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    struct Result {
+        std::function<void()> deliver;
+        qint64 start = 0; /// relative to scheduledAt (usecs)
+        qint64 end = 0;
+    };
+    QtConcurrent::run(QThreadPool::globalInstance(), [work, timer]() {
+        Result result;
+        result.start = timer.nsecsElapsed() / 1000;
+        result.deliver = work();
+        result.end = timer.nsecsElapsed() / 1000;
+        return result;
+    }).then(this, [this, job, requestId, metrics, scheduledAt](const Result &result) {
+        if (job < m_d->nextJobToDeliver) {
+            return; // cancelled
+        }
+        if (metrics) {
+            metrics->addSpan("convert", requestId, scheduledAt + result.start, scheduledAt + result.end);
+        }
+        m_d->finishedJobs.insert(job, [this, requestId, metrics, deliver = result.deliver]() {
+            const qint64 start = metrics ? metrics->now() : 0;
+            deliver();
+            if (metrics) {
+                metrics->addSpan("model insert", requestId, start, metrics->now());
+            }
+        });
+        deliverFinishedJobs();
+    });
+}
+
+/*!
+ * Runs \a deliver, after the results of all work started by runInBackground so far were delivered
+ */
+void IssuesManager::afterBackgroundWork(const std::function<void()> &deliver)
+{
+    m_d->finishedJobs.insert(m_d->nextJob++, deliver);
+    deliverFinishedJobs();
+}
+
+void IssuesManager::deliverFinishedJobs()
+{
+    while (m_d->finishedJobs.contains(m_d->nextJobToDeliver)) {
+        const std::function<void()> deliver = m_d->finishedJobs.take(m_d->nextJobToDeliver);
+        ++m_d->nextJobToDeliver;
+        deliver();
+    }
+}
+
+/*!
+ * Returns true if an update has to fetch all issues. Issues deleted on the server don't show up in incremental
+ * updates, they are only found by a fetch of all issues. That's done at the first update, and then periodically.
+ */
+bool IssuesManager::needsFullSync() const
+{
+    return !m_d->lastFullSyncAt.isValid()
+            || m_d->lastFullSyncAt.secsTo(QDateTime::currentDateTimeUtc()) > kFullSyncIntervalSecs;
+}
+
 bool IssuesManager::requestProjectID(const QUrl &url)
 {
     switch (m_d->repoType) {
     case (REPO_TYPE::GITLAB): {
-        const bool wasBusy = m_d->gitlabClient->requestProjectId(url);
-        return !wasBusy;
+        if (m_d->projectIdRequestId >= 0) {
+            m_d->gitlabClient->cancelRequest(m_d->projectIdRequestId);
+        }
+        m_d->projectIdRequestId = m_d->gitlabClient->requestProjectId(url);
+        return true;
     }
     default:
         qDebug() << "unknown repository type";
@@ -17,10 +17,13 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #pragma once
 
+#include <QList>
 #include <QObject>
 #include <QStringList>
 #include <QUrl>
 
+#include <functional>
+
 namespace tracecommon {
 class IssuesManagerPrivate;
 
@@ -51,6 +54,18 @@ public:
 
     QStringList tagsBuffer();
 
+    /*!
+     * \brief Writes the timing of the latest requests, and of inserting their results, as Chrome trace event JSON.
+     * The file can be opened in chrome://tracing or https://ui.perfetto.dev
+     * \return false if the file could not be written
+     */
+    bool exportRequestTrace(const QString &fileName) const;
+    /*!
+     * \brief Fetches the issues by the GraphQL API instead of the REST API. Takes effect for the projects that are
+     * resolved after this call. \see gitlab::QGitlabClient::setFetchBackend
+     */
+    void setUseGraphQL(bool useGraphQL);
+
 public Q_SLOTS:
     bool requestTags();
     void setProjectID(const int &newProjectID);
@@ -62,9 +77,19 @@ Q_SIGNALS:
     void connectionError(QString errorString);
     void projectUrlChanged(const QUrl &url);
     void tokenChanged(const QString &token);
+    /*!
+     * \brief Sent when a bulk remove or relabel finished
+     * \param failedIssueIDs the issues that could not be changed
+     */
+    void bulkChangeFinished(const QList<int> &failedIssueIDs);
 
 protected:
     void init(IssuesManagerPrivate *priv);
+    void cancelFetch();
+    void cancelAllRequests();
+    void runInBackground(const std::function<std::function<void()>()> &work);
+    void afterBackgroundWork(const std::function<void()> &deliver);
+    bool needsFullSync() const;
 
     int m_projectID = -1;
     QUrl m_projectUrl = {};
@@ -73,6 +98,9 @@ protected:
     bool requestProjectID(const QUrl &url);
 
     IssuesManagerPrivate *m_d = nullptr;
+
+private:
+    void deliverFinishedJobs();
 };
 
 } // namespace tracecommon
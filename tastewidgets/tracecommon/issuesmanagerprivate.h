@@ -17,8 +17,12 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #pragma once
 
+#include "issuecache.h"
 #include "qgitlabclient.h"
 
+#include <QDateTime>
+#include <QMap>
+#include <QSet>
 #include <issuesmanager.h>
 
 namespace tracecommon {
@@ -30,6 +34,20 @@ public:
 
     IssuesManager::REPO_TYPE repoType;
     std::unique_ptr<gitlab::QGitlabClient> gitlabClient;
+    QDateTime lastUpdatedAt; /// Newest update time of all fetched issues, base for incremental updates
+    QDateTime fetchUpdatedAt; /// Newest update time of the running fetch, taken over when the fetch is complete
+    int fetchRequestId = -1; /// ID of the running fetch of issues
+    int tagsRequestId = -1; /// ID of the running fetch of labels
+    int projectIdRequestId = -1; /// ID of the running request of the project ID
+    bool incrementalFetch = false; /// True if the running fetch is an incremental update
+    bool fullSyncFetch = false; /// True if the running fetch gets all issues, to find the ones that were deleted
+    QSet<int> fetchedIssues; /// Issues received by the running full sync
+    QList<int> deletedIssues; /// Issues that were not received anymore by the last full sync
+    QDateTime lastFullSyncAt; /// Time all issues were fetched the last time
+    gitlab::IssueCache issueCache; /// Issues of the last fetch, stored on disk for the next start
+    int nextJob = 0; /// Number of the next work started by IssuesManager::runInBackground
+    int nextJobToDeliver = 0;
+    QMap<int, std::function<void()>> finishedJobs; /// Results of work that finished before its predecessors
 };
 
 } // namespace tracecommon
@@ -0,0 +1,144 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#include "textindex.h"
+
+#include <algorithm>
+
+namespace tracecommon {
+
+void TextIndex::clear()
+{
+    m_issuesOfWord.clear();
+    m_wordsOfIssue.clear();
+    m_wordsContaining.clear();
+}
+
+void TextIndex::insert(int issueID, const QStringList &texts)
+{
+    remove(issueID);
+
+    QSet<QString> issueWords;
+    for (const QString &text : texts) {
+        for (const QString &word : words(text)) {
+            issueWords.insert(word);
+        }
+    }
+    for (const QString &word : std::as_const(issueWords)) {
+        m_issuesOfWord[word].append(issueID);
+    }
+    m_wordsOfIssue.insert(issueID, issueWords.values());
+    m_wordsContaining.clear();
+}
+
+void TextIndex::remove(int issueID)
+{
+    const QStringList issueWords = m_wordsOfIssue.take(issueID);
+    for (const QString &word : issueWords) {
+        auto it = m_issuesOfWord.find(word);
+        if (it == m_issuesOfWord.end()) {
+            continue;
+        }
+        it->removeOne(issueID);
+        if (it->isEmpty()) {
+            m_issuesOfWord.erase(it);
+        }
+    }
+    if (!issueWords.isEmpty()) {
+        m_wordsContaining.clear();
+    }
+}
+
+bool TextIndex::candidates(const QString &text, QSet<int> &issueIDs) const
+{
+    QStringList searchedWords = words(text);
+    searchedWords.removeIf([](const QString &word) { return word.size() < kMinWordLength; });
+    if (searchedWords.isEmpty()) {
+        return false;
+    }
+    searchedWords.removeDuplicates();
+    // Long words match less index words, so the result is small from the start
+    std::sort(searchedWords.begin(), searchedWords.end(),
+            [](const QString &a, const QString &b) { return a.size() > b.size(); });
+
+    QHash<QString, QStringList> lastWordsContaining;
+    lastWordsContaining.swap(m_wordsContaining);
+    issueIDs.clear();
+    bool first = true;
+    for (const QString &searchedWord : std::as_const(searchedWords)) {
+        // Typing more letters only narrows the words found for the previous text
+        const QStringList *indexWords = nullptr;
+        for (auto it = lastWordsContaining.cbegin(); it != lastWordsContaining.cend(); ++it) {
+            if (searchedWord.contains(it.key()) && (!indexWords || it->size() < indexWords->size())) {
+                indexWords = &it.value();
+            }
+        }
+        QStringList &found = m_wordsContaining[searchedWord];
+        if (indexWords) {
+            for (const QString &word : *indexWords) {
+                if (word.contains(searchedWord)) {
+                    found.append(word);
+                }
+            }
+        } else {
+            for (auto it = m_issuesOfWord.cbegin(); it != m_issuesOfWord.cend(); ++it) {
+                if (it.key().contains(searchedWord)) {
+                    found.append(it.key());
+                }
+            }
+        }
+
+        QSet<int> issues;
+        for (const QString &word : std::as_const(found)) {
+            for (int issueID : m_issuesOfWord.value(word)) {
+                if (first || issueIDs.contains(issueID)) {
+                    issues.insert(issueID);
+                }
+            }
+        }
+        issueIDs.swap(issues);
+        first = false;
+        if (issueIDs.isEmpty()) {
+            break;
+        }
+    }
+    return true;
+}
+
+/*!
+ * Splits \a text into case folded words. Every character that is not a letter or a digit separates words.
+ */
+QStringList TextIndex::words(const QString &text)
+{
+    QStringList result;
+    QString word;
+    for (const QChar &c : text) {
+        if (c.isLetterOrNumber()) {
+            word.append(c.toCaseFolded());
+        } else if (!word.isEmpty()) {
+            result.append(word);
+            word.clear();
+        }
+    }
+    if (!word.isEmpty()) {
+        result.append(word);
+    }
+    return result;
+}
+
+} // namespace tracecommon
@@ -0,0 +1,65 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+namespace tracecommon {
+
+/*!
+ * An inverted index of the words in the texts of issues, to find the issues that may contain a text without searching
+ * all the texts.
+ * The texts are split into words (runs of letters and digits) and case folded. The index maps each word to the issues
+ * containing it. To find a text, the words of the index that contain a word of the text are looked up.
+ */
+class TextIndex
+{
+public:
+    /*!
+     * Words of a searched text that are shorter are ignored, as they match too many words to narrow down the search
+     */
+    static constexpr int kMinWordLength = 3;
+
+    void clear();
+    /*!
+     * Adds the \a texts of the issue \a issueID. Texts already indexed for that issue are replaced
+     */
+    void insert(int issueID, const QStringList &texts);
+    void remove(int issueID);
+
+    /*!
+     * Returns the IDs of the issues that might contain \a text (case insensitive). Those still have to be checked.
+     * Returns false if the index can't narrow down the search, because \a text has no word long enough.
+     */
+    bool candidates(const QString &text, QSet<int> &issueIDs) const;
+
+    static QStringList words(const QString &text);
+
+private:
+    QHash<QString, QList<int>> m_issuesOfWord;
+    QHash<int, QStringList> m_wordsOfIssue;
+    /// Words of the index that contain a searched word, for the words of the last search
+    mutable QHash<QString, QStringList> m_wordsContaining;
+};
+
+} // namespace tracecommon
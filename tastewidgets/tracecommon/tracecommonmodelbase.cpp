@@ -17,6 +17,8 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html
 
 #include "tracecommonmodelbase.h"
 
+#include <algorithm>
+
 namespace tracecommon {
 
 TraceCommonModelBase::TraceCommonModelBase(QObject *parent)
@@ -24,4 +26,33 @@ TraceCommonModelBase::TraceCommonModelBase(QObject *parent)
 {
 }
 
+int TraceCommonModelBase::issueIdOfRow(int row) const
+{
+    return index(row, 0).data(IssueIdRole).toInt();
+}
+
+QStringList TraceCommonModelBase::tagsOfRow(int row) const
+{
+    return index(row, 0).data(TagsRole).toStringList();
+}
+
+QStringList TraceCommonModelBase::textsOfRow(int row) const
+{
+    const QModelIndex idx = index(row, 0);
+    return { idx.data(DetailDescriptionRole).toString(), idx.data(TitleRole).toString(),
+        idx.data(AuthorRole).toString() };
+}
+
+bool TraceCommonModelBase::rowContainsText(int row, const QString &text, Qt::CaseSensitivity cs) const
+{
+    const QStringList texts = textsOfRow(row);
+    return std::any_of(texts.begin(), texts.end(), [&](const QString &t) { return t.contains(text, cs); });
+}
+
+bool TraceCommonModelBase::isRowChecked(int row) const
+{
+    Q_UNUSED(row)
+    return false;
+}
+
 } // namespace tracecommon
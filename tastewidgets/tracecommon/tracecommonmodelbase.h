@@ -42,6 +42,25 @@ public:
         UserRole,
     };
     explicit TraceCommonModelBase(QObject *parent = nullptr);
+
+    /*!
+     * Typed access to the data of a row, used by TraceFilterProxyModel to filter without going through data().
+     * The default implementations do use data().
+     */
+    virtual int issueIdOfRow(int row) const;
+    virtual QStringList tagsOfRow(int row) const;
+    /*!
+     * Returns the texts of the issue in \a row that are searched by the text filter: description, title and author
+     */
+    virtual QStringList textsOfRow(int row) const;
+    /*!
+     * Returns true if one of the texts of the issue in \a row contains \a text
+     */
+    bool rowContainsText(int row, const QString &text, Qt::CaseSensitivity cs) const;
+    /*!
+     * Returns true if the issue in \a row is checked by the user. Models without a check state return false
+     */
+    virtual bool isRowChecked(int row) const;
 };
 
 } // namespace tracecommon
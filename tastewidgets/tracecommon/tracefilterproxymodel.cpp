@@ -0,0 +1,262 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#include "tracefilterproxymodel.h"
+
+#include "tracecommonmodelbase.h"
+
+#include <algorithm>
+
+namespace tracecommon {
+
+static const int kMaxRowsToUnindex = 64; /// more removed rows drop the text index instead of updating it
+
+TraceFilterProxyModel::TraceFilterProxyModel(QObject *parent)
+    : QSortFilterProxyModel { parent }
+{
+    setDynamicSortFilter(true);
+    setFilterKeyColumn(-1);
+    // Changes of the data are filtered again if they contain this role (or any role). Text or tags are always changed
+    // with all roles, so the check state is the one that needs to be set.
+    setFilterRole(Qt::CheckStateRole);
+}
+
+void TraceFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    for (const QMetaObject::Connection &connection : std::as_const(m_sourceConnections)) {
+        disconnect(connection);
+    }
+    m_sourceConnections.clear();
+    m_textMatches.clear();
+    clearIndex();
+
+    m_source = qobject_cast<TraceCommonModelBase *>(sourceModel);
+    if (m_source) {
+        // Connected before the base class connects, so the cache and the index are up to date before the rows are
+        // filtered again
+        m_sourceConnections = {
+            connect(m_source, &QAbstractItemModel::dataChanged, this,
+                    [this](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles) {
+                        if (roles != QList<int> { Qt::CheckStateRole }) {
+                            forgetRows(topLeft.row(), bottomRight.row());
+                            indexRows(topLeft.row(), bottomRight.row());
+                        }
+                    }),
+            connect(m_source, &QAbstractItemModel::rowsInserted, this,
+                    [this](const QModelIndex &, int first, int last) { indexRows(first, last); }),
+            connect(m_source, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+                    [this](const QModelIndex &, int first, int last) { forgetRows(first, last); }),
+            connect(m_source, &QAbstractItemModel::modelAboutToBeReset, this, [this]() {
+                m_textMatches.clear();
+                clearIndex();
+            }),
+            connect(m_source, &QAbstractItemModel::modelReset, this, &TraceFilterProxyModel::updateCandidates),
+        };
+        updateCandidates();
+    }
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+/*!
+ * Shows only the rows that contain \a text. An empty text shows all rows
+ */
+void TraceFilterProxyModel::setFilterText(const QString &text)
+{
+    if (text == m_text) {
+        return;
+    }
+
+    if (!m_text.isEmpty() && text.contains(m_text, Qt::CaseInsensitive)) {
+        // Rows without the old text can't contain the new one
+        forgetTextMatches(true);
+    } else if (!text.isEmpty() && m_text.contains(text, Qt::CaseInsensitive)) {
+        // Rows with the old text contain the new one as well
+        forgetTextMatches(false);
+    } else {
+        m_textMatches.clear();
+    }
+    m_text = text;
+    updateCandidates();
+    invalidateRowsFilter();
+}
+
+const QString &TraceFilterProxyModel::filterText() const
+{
+    return m_text;
+}
+
+/*!
+ * Add one more tag to be accepted
+ */
+void TraceFilterProxyModel::addTag(const QString &tag)
+{
+    if (m_tags.contains(tag)) {
+        return;
+    }
+    m_tags.append(tag);
+    invalidateRowsFilter();
+}
+
+/*!
+ * Remove one tag from the list of accepted ones.
+ * If all tags are removed, the filter shows all data
+ */
+void TraceFilterProxyModel::removeTag(const QString &tag)
+{
+    if (m_tags.removeAll(tag) > 0) {
+        invalidateRowsFilter();
+    }
+}
+
+void TraceFilterProxyModel::setCheckedFilter(CheckedFilter filter)
+{
+    if (filter == m_checkedFilter) {
+        return;
+    }
+    m_checkedFilter = filter;
+    invalidateRowsFilter();
+}
+
+TraceFilterProxyModel::CheckedFilter TraceFilterProxyModel::checkedFilter() const
+{
+    return m_checkedFilter;
+}
+
+bool TraceFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (!m_source || sourceParent.isValid()) {
+        return true;
+    }
+
+    if (m_checkedFilter != CheckedFilter::All
+            && m_source->isRowChecked(sourceRow) != (m_checkedFilter == CheckedFilter::Checked)) {
+        return false;
+    }
+
+    if (!m_tags.isEmpty()) {
+        const QStringList tags = m_source->tagsOfRow(sourceRow);
+        const bool hasTag = std::any_of(
+                m_tags.begin(), m_tags.end(), [&tags](const QString &tag) { return tags.contains(tag); });
+        if (!hasTag) {
+            return false;
+        }
+    }
+
+    return matchesText(sourceRow);
+}
+
+bool TraceFilterProxyModel::matchesText(int sourceRow) const
+{
+    if (m_text.isEmpty()) {
+        return true;
+    }
+
+    const int issueID = m_source->issueIdOfRow(sourceRow);
+    auto it = m_textMatches.constFind(issueID);
+    if (it != m_textMatches.constEnd()) {
+        return it.value();
+    }
+    const bool matches = (!m_hasCandidates || m_candidates.contains(issueID))
+            && m_source->rowContainsText(sourceRow, m_text, Qt::CaseInsensitive);
+    m_textMatches.insert(issueID, matches);
+    return matches;
+}
+
+/*!
+ * Removes the cached text results that are \a matched, so those rows are searched again
+ */
+void TraceFilterProxyModel::forgetTextMatches(bool matched)
+{
+    for (auto it = m_textMatches.begin(); it != m_textMatches.end();) {
+        if (it.value() == matched) {
+            it = m_textMatches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/*!
+ * Removes the source rows \a first to \a last from the cached text results and the index, as those changed or are
+ * removed
+ */
+void TraceFilterProxyModel::forgetRows(int first, int last)
+{
+    if (!m_source || (m_textMatches.isEmpty() && !m_indexed)) {
+        return;
+    }
+    if (last - first >= kMaxRowsToUnindex) {
+        // Removing each issue from the index is slower than building it again with the next search
+        clearIndex();
+    }
+    for (int row = first; row <= last; ++row) {
+        const int issueID = m_source->issueIdOfRow(row);
+        m_textMatches.remove(issueID);
+        if (m_indexed) {
+            m_textIndex.remove(issueID);
+        }
+    }
+}
+
+/*!
+ * Adds the new or changed source rows \a first to \a last to the index. They might contain the current text as well
+ */
+void TraceFilterProxyModel::indexRows(int first, int last)
+{
+    if (!m_source || !m_indexed) {
+        return;
+    }
+    for (int row = first; row <= last; ++row) {
+        const int issueID = m_source->issueIdOfRow(row);
+        m_textIndex.insert(issueID, m_source->textsOfRow(row));
+        if (m_hasCandidates) {
+            m_candidates.insert(issueID);
+        }
+    }
+}
+
+/*!
+ * Looks up the issues that might contain the current text. The index is built first, if this is the first search
+ */
+void TraceFilterProxyModel::updateCandidates()
+{
+    m_hasCandidates = false;
+    m_candidates.clear();
+    if (!m_source || m_text.isEmpty()) {
+        return;
+    }
+
+    if (!m_indexed) {
+        for (int row = 0; row < m_source->rowCount(); ++row) {
+            m_textIndex.insert(m_source->issueIdOfRow(row), m_source->textsOfRow(row));
+        }
+        m_indexed = true;
+    }
+    m_hasCandidates = m_textIndex.candidates(m_text, m_candidates);
+}
+
+void TraceFilterProxyModel::clearIndex()
+{
+    m_textIndex.clear();
+    m_indexed = false;
+    m_hasCandidates = false;
+    m_candidates.clear();
+}
+
+} // namespace tracecommon
@@ -0,0 +1,93 @@
+/*
+   Copyright (C) 2024 European Space Agency - <maxime.perrotin@esa.int>
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 2 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Library General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+
+#pragma once
+
+#include "textindex.h"
+
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QSet>
+#include <QSortFilterProxyModel>
+#include <QStringList>
+
+namespace tracecommon {
+
+class TraceCommonModelBase;
+
+/*!
+ * A filter model to filter a requirement or review model for text, tags and the check state, all in one pass.
+ * The rows are read through the typed accessors of TraceCommonModelBase instead of data().
+ *
+ * Text: shows the rows that contain the text (case insensitive) in the title, description or author.
+ * Tags: shows the rows that have at least one of the tags. If no tag is set, all rows are shown.
+ * Checked: shows all rows, only the checked ones or only the unchecked ones.
+ *
+ * The result of the text filter is cached per issue. So changing the tags or the check filter does not search the
+ * texts again, and typing more text only searches the rows that matched so far.
+ * The words of the texts are indexed with the first search (and kept up to date from then on), so only the issues
+ * that have words containing the words of the text are searched.
+ */
+class TraceFilterProxyModel : public QSortFilterProxyModel
+{
+public:
+    enum class CheckedFilter
+    {
+        All,
+        Checked,
+        Unchecked,
+    };
+
+    explicit TraceFilterProxyModel(QObject *parent = nullptr);
+
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    void setFilterText(const QString &text);
+    const QString &filterText() const;
+
+    void addTag(const QString &tag);
+    void removeTag(const QString &tag);
+
+    void setCheckedFilter(CheckedFilter filter);
+    CheckedFilter checkedFilter() const;
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    bool matchesText(int sourceRow) const;
+    void forgetTextMatches(bool matched);
+    void forgetRows(int first, int last);
+    void indexRows(int first, int last);
+    void updateCandidates();
+    void clearIndex();
+
+    QPointer<TraceCommonModelBase> m_source;
+    QList<QMetaObject::Connection> m_sourceConnections;
+    QString m_text;
+    QStringList m_tags;
+    CheckedFilter m_checkedFilter = CheckedFilter::All;
+    mutable QHash<int, bool> m_textMatches; /// if the text was found, by issue ID
+    TextIndex m_textIndex;
+    bool m_indexed = false;
+    bool m_hasCandidates = false;
+    QSet<int> m_candidates; /// issues that might contain the text (if m_hasCandidates)
+};
+
+} // namespace tracecommon